@@ -30,55 +30,11 @@ void AAmmo::BeginPlay()
 	PickupSphere -> OnComponentBeginOverlap.AddDynamic(this, &AAmmo::OnPickupSphereOverlap);
 }
 
-void AAmmo::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-}
-
 void AAmmo::UpdateItemProperties(EItemState State)
 {
 	Super::UpdateItemProperties(State);
 
-	switch(State)
-	{
-	case EItemState::EIS_Pickup:
-		AmmoMesh -> SetSimulatePhysics(false);
-		AmmoMesh -> SetEnableGravity(false);
-		AmmoMesh -> SetVisibility(true);
-		AmmoMesh -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AmmoMesh -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	case EItemState::EIS_EquipInterp:
-		AmmoMesh -> SetSimulatePhysics(false);
-		AmmoMesh -> SetEnableGravity(false);
-		AmmoMesh -> SetVisibility(true);
-		AmmoMesh -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AmmoMesh -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	case EItemState::EIS_Equipped:
-		AmmoMesh -> SetSimulatePhysics(false);
-		AmmoMesh -> SetEnableGravity(false);
-		AmmoMesh -> SetVisibility(true);
-		AmmoMesh -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AmmoMesh -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	case EItemState::EIS_Falling:
-		AmmoMesh -> SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		AmmoMesh -> SetSimulatePhysics(true);
-		AmmoMesh -> SetEnableGravity(true);
-		AmmoMesh -> SetVisibility(true);
-		AmmoMesh -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AmmoMesh -> SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldStatic, ECollisionResponse::ECR_Block);
-		break;
-
-	case EItemState::EIS_PickedUp:
-		AmmoMesh -> SetSimulatePhysics(false);
-		AmmoMesh -> SetEnableGravity(false);
-		AmmoMesh -> SetVisibility(false);
-		AmmoMesh -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AmmoMesh -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	}
+	ApplyCollisionProfile(AmmoMesh, GetMeshCollisionProfile(State));
 }
 
 void AAmmo::OnPickupSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
@@ -92,6 +48,13 @@ void AAmmo::OnPickupSphereOverlap(UPrimitiveComponent* OverlappedComponent, AAct
 	}
 }
 
+void AAmmo::OnAcquiredFromPool()
+{
+	Super::OnAcquiredFromPool();
+
+	PickupSphere -> SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+}
+
 void AAmmo::EnableCustomDepth()
 {
 	AmmoMesh -> SetRenderCustomDepth(true);	
@@ -14,14 +14,15 @@ class SHOOTER_API AAmmo : public AItem
 
 public:
 	AAmmo();
-
-	virtual void Tick(float DeltaTime) override;
 	
 protected:
 	virtual void BeginPlay() override;
 	
 	virtual void UpdateItemProperties(EItemState State) override;
 
+	/** Arm the PickupSphere again, it got disabled when the ammo was picked up */
+	virtual void OnAcquiredFromPool() override;
+
 	UFUNCTION()
 	void OnPickupSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
 	int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -0,0 +1,129 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "BakedCurveSubsystem.h"
+
+#include "Shooter.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+#include "Engine/Engine.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Baked Curves"), STAT_BakedCurves, STATGROUP_Shooter);
+
+void FBakedCurve::Bake(const UCurveFloat& Curve, int32 NumSamples)
+{
+	NumSamples = FMath::Max(NumSamples, 2);
+	Curve.GetTimeRange(MinTime, MaxTime);
+
+	const float Duration{ MaxTime - MinTime };
+	SamplesPerSecond = Duration > UE_SMALL_NUMBER ? (NumSamples - 1) / Duration : 0.f;
+
+	Samples.SetNumUninitialized(NumSamples);
+	for(int32 i = 0; i < NumSamples; i++)
+	{
+		const float Time{ Duration > UE_SMALL_NUMBER ? MinTime + Duration * i / (NumSamples - 1) : MinTime };
+		Samples[i] = Curve.GetFloatValue(Time);
+	}
+}
+
+void FBakedVectorCurve::Bake(const UCurveVector& Curve, int32 NumSamples)
+{
+	NumSamples = FMath::Max(NumSamples, 2);
+	Curve.GetTimeRange(MinTime, MaxTime);
+
+	const float Duration{ MaxTime - MinTime };
+	SamplesPerSecond = Duration > UE_SMALL_NUMBER ? (NumSamples - 1) / Duration : 0.f;
+
+	Samples.SetNumUninitialized(NumSamples);
+	for(int32 i = 0; i < NumSamples; i++)
+	{
+		const float Time{ Duration > UE_SMALL_NUMBER ? MinTime + Duration * i / (NumSamples - 1) : MinTime };
+		Samples[i] = FVector3f(Curve.GetVectorValue(Time));
+	}
+}
+
+void FBakedVectorCurve::EvaluateBatch(TArrayView<const float> Times, TArrayView<FVector> OutValues) const
+{
+	check(Times.Num() == OutValues.Num());
+
+	// Straight loop without branches, so the compiler can vectorize it
+	const float Range{ MaxTime - MinTime };
+	const int32 LastIndex{ Samples.Num() - 2 };
+	const FVector3f* SampleData = Samples.GetData();
+	for(int32 i = 0; i < Times.Num(); i++)
+	{
+		const float SampleTime{ FMath::Clamp(Times[i] - MinTime, 0.f, Range) * SamplesPerSecond };
+		const int32 Index{ FMath::Min(static_cast<int32>(SampleTime), LastIndex) };
+		OutValues[i] = FVector(FMath::Lerp(SampleData[Index], SampleData[Index + 1], SampleTime - Index));
+	}
+}
+
+void UBakedCurveSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_BakedCurves, BakedCurves.Num() + BakedVectorCurves.Num());
+	BakedCurves.Empty();
+	BakedVectorCurves.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UBakedCurveSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+const FBakedCurve* UBakedCurveSubsystem::FindOrBakeCurve(const UCurveFloat* Curve)
+{
+	if(Curve == nullptr) return nullptr;
+
+	if(const TUniquePtr<FBakedCurve>* BakedCurve = BakedCurves.Find(FObjectKey(Curve)))
+	{
+		return BakedCurve -> Get();
+	}
+
+	TUniquePtr<FBakedCurve> NewCurve = MakeUnique<FBakedCurve>();
+	NewCurve -> Bake(*Curve, SamplesPerCurve);
+	INC_DWORD_STAT(STAT_BakedCurves);
+	return BakedCurves.Add(FObjectKey(Curve), MoveTemp(NewCurve)).Get();
+}
+
+const FBakedCurve* UBakedCurveSubsystem::FindOrBakeCurve(const UObject* WorldContextObject, const UCurveFloat* Curve)
+{
+	const UWorld* World = GEngine -> GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	UBakedCurveSubsystem* BakedCurveSubsystem = World ? World -> GetSubsystem<UBakedCurveSubsystem>() : nullptr;
+	return BakedCurveSubsystem ? BakedCurveSubsystem -> FindOrBakeCurve(Curve) : nullptr;
+}
+
+float UBakedCurveSubsystem::Evaluate(const FBakedCurve* BakedCurve, const UCurveFloat* Curve, float Time)
+{
+	if(BakedCurve) return BakedCurve -> Evaluate(Time);
+	return Curve ? Curve -> GetFloatValue(Time) : 0.f;
+}
+
+const FBakedVectorCurve* UBakedCurveSubsystem::FindOrBakeCurve(const UCurveVector* Curve)
+{
+	if(Curve == nullptr) return nullptr;
+
+	if(const TUniquePtr<FBakedVectorCurve>* BakedCurve = BakedVectorCurves.Find(FObjectKey(Curve)))
+	{
+		return BakedCurve -> Get();
+	}
+
+	TUniquePtr<FBakedVectorCurve> NewCurve = MakeUnique<FBakedVectorCurve>();
+	NewCurve -> Bake(*Curve, SamplesPerCurve);
+	INC_DWORD_STAT(STAT_BakedCurves);
+	return BakedVectorCurves.Add(FObjectKey(Curve), MoveTemp(NewCurve)).Get();
+}
+
+const FBakedVectorCurve* UBakedCurveSubsystem::FindOrBakeCurve(const UObject* WorldContextObject, const UCurveVector* Curve)
+{
+	const UWorld* World = GEngine -> GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	UBakedCurveSubsystem* BakedCurveSubsystem = World ? World -> GetSubsystem<UBakedCurveSubsystem>() : nullptr;
+	return BakedCurveSubsystem ? BakedCurveSubsystem -> FindOrBakeCurve(Curve) : nullptr;
+}
+
+FVector UBakedCurveSubsystem::Evaluate(const FBakedVectorCurve* BakedCurve, const UCurveVector* Curve, float Time)
+{
+	if(BakedCurve) return BakedCurve -> Evaluate(Time);
+	return Curve ? Curve -> GetVectorValue(Time) : FVector::ZeroVector;
+}
@@ -0,0 +1,97 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "BakedCurveSubsystem.generated.h"
+
+class UCurveFloat;
+class UCurveVector;
+
+/** A float curve sampled at uniform steps, evaluated by linear interpolation between the samples */
+struct FBakedCurve
+{
+	float MinTime{ 0.f };
+	float MaxTime{ 0.f };
+
+	/** Number of samples per unit of time */
+	float SamplesPerSecond{ 0.f };
+
+	TArray<float> Samples;
+
+	/** Sample the curve over its time range */
+	void Bake(const UCurveFloat& Curve, int32 NumSamples);
+
+	/** Value at the time, clamped to the curve's time range */
+	FORCEINLINE float Evaluate(float Time) const
+	{
+		const float SampleTime{ FMath::Clamp(Time - MinTime, 0.f, MaxTime - MinTime) * SamplesPerSecond };
+		const int32 Index{ FMath::Min(static_cast<int32>(SampleTime), Samples.Num() - 2) };
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], SampleTime - Index);
+	}
+};
+
+/** A vector curve baked like FBakedCurve, the three channels sampled together into one table */
+struct FBakedVectorCurve
+{
+	float MinTime{ 0.f };
+	float MaxTime{ 0.f };
+
+	/** Number of samples per unit of time */
+	float SamplesPerSecond{ 0.f };
+
+	TArray<FVector3f> Samples;
+
+	/** Sample the curve over its time range */
+	void Bake(const UCurveVector& Curve, int32 NumSamples);
+
+	/** Value at the time, clamped to the curve's time range */
+	FORCEINLINE FVector Evaluate(float Time) const
+	{
+		const float SampleTime{ FMath::Clamp(Time - MinTime, 0.f, MaxTime - MinTime) * SamplesPerSecond };
+		const int32 Index{ FMath::Min(static_cast<int32>(SampleTime), Samples.Num() - 2) };
+		return FVector(FMath::Lerp(Samples[Index], Samples[Index + 1], SampleTime - Index));
+	}
+
+	/** Evaluate many times at once, e.g. the glow pulse of every item using the curve */
+	void EvaluateBatch(TArrayView<const float> Times, TArrayView<FVector> OutValues) const;
+};
+
+/**
+ * Bakes each float and vector curve asset into a lookup table once, shared by every item and weapon using it,
+ * so per-frame curve evaluation doesn't search keys.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UBakedCurveSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Baked version of the curve, baked on first request */
+	const FBakedCurve* FindOrBakeCurve(const UCurveFloat* Curve);
+
+	/** Look the baked curve up through the world's subsystem, null if there is none */
+	static const FBakedCurve* FindOrBakeCurve(const UObject* WorldContextObject, const UCurveFloat* Curve);
+
+	/** Evaluate the baked curve if there is one, the curve asset otherwise */
+	static float Evaluate(const FBakedCurve* BakedCurve, const UCurveFloat* Curve, float Time);
+
+	const FBakedVectorCurve* FindOrBakeCurve(const UCurveVector* Curve);
+	static const FBakedVectorCurve* FindOrBakeCurve(const UObject* WorldContextObject, const UCurveVector* Curve);
+	static FVector Evaluate(const FBakedVectorCurve* BakedCurve, const UCurveVector* Curve, float Time);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TMap<FObjectKey, TUniquePtr<FBakedCurve>> BakedCurves;
+	TMap<FObjectKey, TUniquePtr<FBakedVectorCurve>> BakedVectorCurves;
+
+	/** Number of samples taken over a curve's time range */
+	UPROPERTY(Config)
+	int32 SamplesPerCurve{ 128 };
+};
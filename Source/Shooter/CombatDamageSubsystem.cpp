@@ -0,0 +1,134 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "CombatDamageSubsystem.h"
+
+#include "HitNumberManager.h"
+#include "HitReactionInterface.h"
+#include "Shooter.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Apply Queued Damage"), STAT_ApplyQueuedDamage, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Damage Hits"), STAT_QueuedDamageHits, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damaged Victims"), STAT_DamagedVictims, STATGROUP_Shooter);
+
+namespace CombatDamage
+{
+	/** Let the victim react once to all the hits it took */
+	static void ReactToHits(AActor* Victim, int32 HitCount)
+	{
+		if(IsValid(Victim) && Victim -> Implements<UHitReactionInterface>())
+		{
+			IHitReactionInterface::Execute_HitReact(Victim, HitCount);
+		}
+	}
+}
+
+void UCombatDamageSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UCombatDamageSubsystem::OnWorldPostActorTick);
+}
+
+void UCombatDamageSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PendingDamage.Empty();
+	VictimIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UCombatDamageSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FCombatDamageRecord& UCombatDamageSubsystem::FindOrAddRecord(AActor* Victim)
+{
+	if(const int32* Index = VictimIndices.Find(FObjectKey(Victim)))
+	{
+		return PendingDamage[*Index];
+	}
+	VictimIndices.Add(FObjectKey(Victim), PendingDamage.Num());
+	FCombatDamageRecord& Record = PendingDamage.AddDefaulted_GetRef();
+	Record.Victim = Victim;
+	return Record;
+}
+
+void UCombatDamageSubsystem::QueueDamage(AActor* Victim, float Damage, AController* Instigator,
+	AActor* DamageCauser)
+{
+	if(Victim == nullptr) return;
+	INC_DWORD_STAT(STAT_QueuedDamageHits);
+
+	FCombatDamageRecord& Record = FindOrAddRecord(Victim);
+	Record.Damage += Damage;
+	Record.HitCount++;
+	Record.Instigator = Instigator;
+	Record.DamageCauser = DamageCauser;
+}
+
+void UCombatDamageSubsystem::QueueDamage(AActor* Victim, float Damage, AController* Instigator,
+	AActor* DamageCauser, const FVector& HitLocation, bool bHeadShot)
+{
+	if(Victim == nullptr) return;
+	QueueDamage(Victim, Damage, Instigator, DamageCauser);
+
+	FCombatDamageRecord& Record = FindOrAddRecord(Victim);
+	Record.HitLocation = HitLocation;
+	Record.bHeadShot |= bHeadShot;
+	Record.bShowHitNumber = true;
+}
+
+void UCombatDamageSubsystem::QueueWorldDamage(const UObject* WorldContextObject, AActor* Victim, float Damage,
+	AController* Instigator, AActor* DamageCauser)
+{
+	const UWorld* World = GEngine -> GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	UCombatDamageSubsystem* DamageSubsystem = World ? World -> GetSubsystem<UCombatDamageSubsystem>() : nullptr;
+	if(DamageSubsystem)
+	{
+		DamageSubsystem -> QueueDamage(Victim, Damage, Instigator, DamageCauser);
+	}
+	else
+	{
+		UGameplayStatics::ApplyDamage(Victim, Damage, Instigator, DamageCauser, UDamageType::StaticClass());
+		CombatDamage::ReactToHits(Victim, 1);
+	}
+}
+
+void UCombatDamageSubsystem::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	// The delegate is shared by every world, only handle our own
+	if(World != GetWorld() || PendingDamage.Num() == 0) return;
+
+	ApplyPendingDamage();
+}
+
+void UCombatDamageSubsystem::ApplyPendingDamage()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ApplyQueuedDamage);
+	INC_DWORD_STAT_BY(STAT_DamagedVictims, PendingDamage.Num());
+
+	// Move the batch out first, taking damage may queue more (e.g. explosions)
+	TArray<FCombatDamageRecord> Records = MoveTemp(PendingDamage);
+	PendingDamage.Reset();
+	VictimIndices.Reset();
+
+	for(const FCombatDamageRecord& Record : Records)
+	{
+		AActor* Victim = Record.Victim.Get();
+		if(Victim == nullptr) continue;
+
+		const float Damage = UGameplayStatics::ApplyDamage(Victim, Record.Damage, Record.Instigator.Get(),
+			Record.DamageCauser.Get(), UDamageType::StaticClass());
+		// Stun roll and hit montage once per victim, not once per bullet
+		CombatDamage::ReactToHits(Victim, Record.HitCount);
+
+		if(Record.bShowHitNumber)
+		{
+			UHitNumberManager::ShowWorldHitNumber(Victim, Victim, Damage, Record.HitLocation, Record.bHeadShot);
+		}
+	}
+}
@@ -0,0 +1,78 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "CombatDamageSubsystem.generated.h"
+
+/** Damage dealt to one victim, every hit landing on it during a frame is merged into a single record */
+struct FCombatDamageRecord
+{
+	TWeakObjectPtr<AActor> Victim;
+
+	/** Instigator and causer of the latest hit */
+	TWeakObjectPtr<AController> Instigator;
+	TWeakObjectPtr<AActor> DamageCauser;
+
+	float Damage{ 0.f };
+
+	/** Number of hits merged into this record */
+	int32 HitCount{ 0 };
+
+	/** Location of the latest hit, used for the hit number */
+	FVector HitLocation{ FVector::ZeroVector };
+
+	/** Whether any of the merged hits was a headshot */
+	bool bHeadShot{ false };
+
+	/** Whether the victim should show a hit number once the damage is applied */
+	bool bShowHitNumber{ false };
+};
+
+/**
+ * Collects the damage dealt during a frame and merges every hit on the same victim.
+ * Damage is applied once per victim at the end of the frame, so the victim only takes a single
+ * death / stun decision and Blackboard update no matter how many bullets or melee hits landed.
+ * Victims implementing IHitReactionInterface then react once to the merged hits.
+ */
+UCLASS()
+class SHOOTER_API UCombatDamageSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Queue damage for the victim, applied at the end of the frame */
+	void QueueDamage(AActor* Victim, float Damage, AController* Instigator, AActor* DamageCauser);
+
+	/** Queue damage for the victim and show a hit number for the merged damage once applied */
+	void QueueDamage(AActor* Victim, float Damage, AController* Instigator, AActor* DamageCauser,
+		const FVector& HitLocation, bool bHeadShot);
+
+	/** Queue damage through the world's subsystem, applies it right away if the world has none */
+	static void QueueWorldDamage(const UObject* WorldContextObject, AActor* Victim, float Damage,
+		AController* Instigator, AActor* DamageCauser);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FCombatDamageRecord& FindOrAddRecord(AActor* Victim);
+
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Apply the merged damage of every victim hit this frame */
+	void ApplyPendingDamage();
+
+	/** One record per victim hit this frame */
+	TArray<FCombatDamageRecord> PendingDamage;
+
+	/** Victim -> index into PendingDamage */
+	TMap<FObjectKey, int32> VictimIndices;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -0,0 +1,161 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "CombatSnapshotSubsystem.h"
+
+#include "InventoryComponent.h"
+#include "Shooter.h"
+#include "ShooterCharacter.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Snapshot Capture"), STAT_CombatSnapshotCapture, STATGROUP_Shooter);
+DECLARE_CYCLE_STAT(TEXT("Combat Snapshot Restore"), STAT_CombatSnapshotRestore, STATGROUP_Shooter);
+
+namespace CombatSnapshot
+{
+	/** First bytes of every snapshot file */
+	constexpr uint32 Magic{ 0x53484353 }; // "SHCS"
+}
+
+FArchive& operator<<(FArchive& Ar, FWeaponSnapshot& Weapon)
+{
+	Ar << Weapon.WeaponClassPath;
+	Ar << Weapon.WeaponType;
+	Ar << Weapon.Ammo;
+	Ar << Weapon.SlotIndex;
+	return Ar;
+}
+
+bool FCombatSnapshot::Serialize(FArchive& Ar)
+{
+	uint32 Magic{ CombatSnapshot::Magic };
+	int32 Version{ static_cast<int32>(ECombatSnapshotVersion::Latest) };
+	Ar << Magic;
+	Ar << Version;
+	if(Magic != CombatSnapshot::Magic || Version < static_cast<int32>(ECombatSnapshotVersion::Initial)
+		|| Version > static_cast<int32>(ECombatSnapshotVersion::Latest))
+	{
+		Ar.SetError();
+		return false;
+	}
+
+	Ar << Health;
+	Ar << Ammo;
+	Ar << Weapons;
+	Ar << EquippedSlotIndex;
+	return !Ar.IsError();
+}
+
+bool FCombatSnapshot::HasValidSlots(int32 Capacity) const
+{
+	uint64 UsedSlots{ 0 };
+	for(const FWeaponSnapshot& Weapon : Weapons)
+	{
+		if(Weapon.SlotIndex < 0 || Weapon.SlotIndex >= FMath::Min(Capacity, UInventoryComponent::MaxCapacity)) return false;
+
+		const uint64 SlotBit{ uint64(1) << Weapon.SlotIndex };
+		if(UsedSlots & SlotBit) return false;
+		UsedSlots |= SlotBit;
+	}
+	return true;
+}
+
+void UCombatSnapshotSubsystem::SaveCheckpoint(const AShooterCharacter* Character)
+{
+	if(Character == nullptr) return;
+
+	FCombatSnapshot Snapshot;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_CombatSnapshotCapture);
+		Character -> CaptureCombatSnapshot(Snapshot);
+	}
+
+	if(bSaveInProgress) // Only the latest state matters, replace whatever was waiting
+	{
+		QueuedSnapshot = MoveTemp(Snapshot);
+		return;
+	}
+	StartSave(MoveTemp(Snapshot));
+}
+
+void UCombatSnapshotSubsystem::StartSave(FCombatSnapshot&& Snapshot)
+{
+	bSaveInProgress = true;
+
+	TWeakObjectPtr<UCombatSnapshotSubsystem> WeakThis(this);
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Snapshot = MoveTemp(Snapshot), FilePath = GetCheckpointFilePath()]() mutable
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		// Written next to the checkpoint and moved over it, a crash mid-write never leaves a truncated checkpoint
+		const FString TempFilePath{ FilePath + TEXT(".tmp") };
+		const bool bSaved{ Snapshot.Serialize(Writer) && FFileHelper::SaveArrayToFile(Bytes, *TempFilePath)
+			&& IFileManager::Get().Move(*FilePath, *TempFilePath, true) };
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, bSaved]()
+		{
+			if(UCombatSnapshotSubsystem* Subsystem = WeakThis.Get())
+			{
+				Subsystem -> FinishSave(bSaved);
+			}
+		});
+	});
+}
+
+void UCombatSnapshotSubsystem::FinishSave(bool bSaved)
+{
+	bSaveInProgress = false;
+	if(!bSaved)
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Failed to write checkpoint %s"), *GetCheckpointFilePath());
+	}
+
+	if(QueuedSnapshot.IsSet())
+	{
+		FCombatSnapshot Snapshot = MoveTemp(QueuedSnapshot.GetValue());
+		QueuedSnapshot.Reset();
+		StartSave(MoveTemp(Snapshot));
+	}
+}
+
+bool UCombatSnapshotSubsystem::LoadCheckpoint(AShooterCharacter* Character)
+{
+	if(Character == nullptr) return false;
+
+	// A checkpoint is a few hundred bytes, reading it is cheaper than a round trip to a worker thread
+	TArray<uint8> Bytes;
+	if(!FFileHelper::LoadFileToArray(Bytes, *GetCheckpointFilePath(), FILEREAD_Silent)) return false;
+
+	FCombatSnapshot Snapshot;
+	FMemoryReader Reader(Bytes);
+	if(!Snapshot.Serialize(Reader))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Checkpoint %s is unreadable or from a newer version"), *GetCheckpointFilePath());
+		return false;
+	}
+	// Weapons sharing a slot would be spawned and then lost when the next one replaces them
+	if(!Snapshot.HasValidSlots(Character -> GetInventoryComponent() -> GetCapacity()))
+	{
+		UE_LOG(LogShooter, Warning, TEXT("Checkpoint %s has weapons in duplicate or invalid slots"), *GetCheckpointFilePath());
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_CombatSnapshotRestore);
+	Character -> RestoreCombatSnapshot(Snapshot);
+	return true;
+}
+
+bool UCombatSnapshotSubsystem::HasCheckpoint() const
+{
+	return FPaths::FileExists(GetCheckpointFilePath());
+}
+
+FString UCombatSnapshotSubsystem::GetCheckpointFilePath() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SaveGames"), CheckpointSlotName + TEXT(".sav"));
+}
@@ -0,0 +1,99 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "WeaponType.h"
+#include "CombatSnapshotSubsystem.generated.h"
+
+class AShooterCharacter;
+
+/** Versions of the snapshot format, add new ones before Latest */
+enum class ECombatSnapshotVersion : int32
+{
+	Initial = 1,
+
+	LatestPlusOne,
+	Latest = LatestPlusOne - 1
+};
+
+/** A weapon in one of the inventory slots */
+struct FWeaponSnapshot
+{
+	/** Path of the weapon blueprint class */
+	FString WeaponClassPath;
+
+	EWeaponType WeaponType{ EWeaponType::EWT_SubmachineGun };
+
+	/** Ammo in the magazine */
+	int32 Ammo{ 0 };
+
+	int8 SlotIndex{ INDEX_NONE };
+
+	friend FArchive& operator<<(FArchive& Ar, FWeaponSnapshot& Weapon);
+};
+
+/** Plain data copy of the character's combat state, safe to hand to another thread */
+struct FCombatSnapshot
+{
+	float Health{ 0.f };
+
+	/** Carried ammo, indexed by EAmmoType */
+	TArray<int32> Ammo;
+
+	TArray<FWeaponSnapshot> Weapons;
+
+	int8 EquippedSlotIndex{ INDEX_NONE };
+
+	/** Read or write the snapshot, with a header for the format version
+	 *  @return False if the data isn't a snapshot this version can read
+	 */
+	bool Serialize(FArchive& Ar);
+
+	/** True if every weapon is in its own slot, within the inventory capacity */
+	bool HasValidSlots(int32 Capacity) const;
+};
+
+/**
+ * Checkpoint saves of the character's health, ammo and inventory.
+ * The state is copied on the game thread, then serialized and written on a worker thread so saving never stalls a frame.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UCombatSnapshotSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Copy the character's state and write it to the checkpoint file in the background */
+	UFUNCTION(BlueprintCallable, Category = Checkpoint)
+	void SaveCheckpoint(const AShooterCharacter* Character);
+
+	/** Read the checkpoint file and restore the character's state from it
+	 *  @return False if there is no readable checkpoint
+	 */
+	UFUNCTION(BlueprintCallable, Category = Checkpoint)
+	bool LoadCheckpoint(AShooterCharacter* Character);
+
+	UFUNCTION(BlueprintPure, Category = Checkpoint)
+	bool HasCheckpoint() const;
+
+private:
+	/** Serialize and write the snapshot on a worker thread */
+	void StartSave(FCombatSnapshot&& Snapshot);
+
+	/** Called on the game thread once a background save is written */
+	void FinishSave(bool bSaved);
+
+	FString GetCheckpointFilePath() const;
+
+	/** Name of the checkpoint file under Saved/SaveGames */
+	UPROPERTY(Config)
+	FString CheckpointSlotName{ TEXT("Checkpoint") };
+
+	/** True while a save is being written on a worker thread */
+	bool bSaveInProgress{ false };
+
+	/** Latest snapshot requested while a save was in progress, written once it finishes */
+	TOptional<FCombatSnapshot> QueuedSnapshot;
+};
@@ -0,0 +1,84 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "CorpseManagerSubsystem.h"
+
+#include "Shooter.h"
+#include "Enemy.h"
+#include "EnemyPoolSubsystem.h"
+#include "TimerManager.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Corpses"), STAT_Corpses, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corpse Evictions"), STAT_CorpseEvictions, STATGROUP_Shooter);
+
+void UCorpseManagerSubsystem::Deinitialize()
+{
+	if(UWorld* World = GetWorld())
+	{
+		World -> GetTimerManager().ClearTimer(ExpireTimer);
+	}
+	DEC_DWORD_STAT_BY(STAT_Corpses, Corpses.Num());
+	Corpses.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UCorpseManagerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCorpseManagerSubsystem::AddCorpse(AEnemy* Enemy, float Lifetime)
+{
+	if(!IsValid(Enemy)) return;
+
+	Enemy -> BecomeCorpse();
+
+	FCorpseEntry& Entry = Corpses.AddDefaulted_GetRef();
+	Entry.Enemy = Enemy;
+	Entry.ExpireTime = GetWorld() -> GetTimeSeconds() + Lifetime;
+	INC_DWORD_STAT(STAT_Corpses);
+
+	// Oldest first, they have been lying around the longest
+	while(Corpses.Num() > FMath::Max(MaxCorpses, 0))
+	{
+		EvictCorpse(0);
+	}
+
+	FTimerManager& TimerManager = GetWorld() -> GetTimerManager();
+	if(Corpses.Num() > 0 && !TimerManager.IsTimerActive(ExpireTimer))
+	{
+		TimerManager.SetTimer(ExpireTimer, this, &UCorpseManagerSubsystem::EvictExpiredCorpses, ExpireCheckInterval, true);
+	}
+}
+
+void UCorpseManagerSubsystem::EvictExpiredCorpses()
+{
+	const float Now{ GetWorld() -> GetTimeSeconds() };
+	for(int32 i = Corpses.Num() - 1; i >= 0; i--)
+	{
+		if(Corpses[i].ExpireTime <= Now)
+		{
+			EvictCorpse(i);
+		}
+	}
+
+	if(Corpses.Num() == 0)
+	{
+		GetWorld() -> GetTimerManager().ClearTimer(ExpireTimer);
+	}
+}
+
+void UCorpseManagerSubsystem::EvictCorpse(int32 Index)
+{
+	AEnemy* Enemy = Corpses[Index].Enemy;
+	// Keeps the order, the array is only as long as MaxCorpses
+	Corpses.RemoveAt(Index);
+	DEC_DWORD_STAT(STAT_Corpses);
+
+	// Skip enemies destroyed, or already back in the pool, while lying around
+	if(!IsValid(Enemy) || !Enemy -> IsDying() || Enemy -> IsHidden()) return;
+
+	UEnemyPoolSubsystem::ReleasePooledEnemy(Enemy);
+	INC_DWORD_STAT(STAT_CorpseEvictions);
+}
@@ -0,0 +1,61 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CorpseManagerSubsystem.generated.h"
+
+class AEnemy;
+
+/** A dead enemy left lying around */
+USTRUCT()
+struct FCorpseEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AEnemy* Enemy{ nullptr };
+
+	/** World time the corpse goes back to the pool at */
+	float ExpireTime{ 0.f };
+};
+
+/**
+ * Keeps a capped number of dead enemies as frozen, collisionless meshes. Past the cap the oldest corpse is evicted,
+ * and every corpse is evicted once its time is up. Evicted enemies go back to the UEnemyPoolSubsystem.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UCorpseManagerSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Strip the dead enemy down to its frozen mesh and keep it for Lifetime seconds at most */
+	void AddCorpse(AEnemy* Enemy, float Lifetime);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void EvictExpiredCorpses();
+
+	/** Send the corpse back to the enemy pool */
+	void EvictCorpse(int32 Index);
+
+	/** Corpses from oldest to newest */
+	UPROPERTY()
+	TArray<FCorpseEntry> Corpses;
+
+	FTimerHandle ExpireTimer;
+
+	/** Most corpses lying around at once */
+	UPROPERTY(Config)
+	int32 MaxCorpses{ 16 };
+
+	/** Time between two checks for expired corpses */
+	UPROPERTY(Config)
+	float ExpireCheckInterval{ 0.5f };
+};
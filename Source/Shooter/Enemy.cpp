@@ -3,13 +3,20 @@
 
 #include "Enemy.h"
 
+#include "CombatDamageSubsystem.h"
+#include "CorpseManagerSubsystem.h"
+#include "EnemyAnimBudgetSubsystem.h"
 #include "EnemyController.h"
+#include "EnemyLODSubsystem.h"
+#include "EnemyMeshComponent.h"
+#include "EnemyPerceptionSubsystem.h"
+#include "EnemyPoolSubsystem.h"
+#include "HitNumberManager.h"
+#include "HitZoneSubsystem.h"
+#include "ParticlePoolSubsystem.h"
 #include "ShooterCharacter.h"
-#include "BehaviorTree/BlackboardComponent.h"
-#include "Blueprint/UserWidget.h"
-#include "Components/BoxComponent.h"
+#include "BrainComponent.h"
 #include "Components/CapsuleComponent.h"
-#include "Components/SphereComponent.h"
 #include "Engine/SkeletalMeshSocket.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -19,45 +26,49 @@
 
 
 // Sets default values
-AEnemy::AEnemy():
+AEnemy::AEnemy(const FObjectInitializer& ObjectInitializer):
+Super(ObjectInitializer.SetDefaultSubobjectClass<UEnemyMeshComponent>(ACharacter::MeshComponentName)),
 MaxHealth(400.f),
 Health(0.f),
 HitDamage(20.f),
-HeadBone("head"),
 HealthBarDisplayDuration(4.f),
 HitSectionName("HitReactFront"),
 bCanHitReact(true),
 HitReactDurationMin(0.5f),
 HitReactDurationMax(0.75f),
-HitNumberDestroyTime(1.5f),
 AttackRFast("AttackRFast"),
 AttackR("AttackR"),
 AttackLFast("AttackLFast"),
 AttackL("AttackL"),
 RightMeleeTipSocketName(TEXT("FX_Trail_R_01")),
 LeftMeleeTipSocketName(TEXT("FX_Trail_L_01")),
+MeleeTraceRadius(20.f),
 bDying(false),
 DeathDestroyDuration(10.f),
 bStunned(false),
 StunChance(0.2f),
-bInAttackRange(false)
+bInAttackRange(false),
+// Radius the agro and attack range spheres had, GruxBP never overrode the sphere component default
+AgroRadius(32.f),
+AttackRangeRadius(32.f)
 {
 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.bCanEverTick = true;
+	// Enemies spawned by the wave spawner need their controller as much as the placed ones
+	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
+	// Melee sweeps read the sockets after the animation of the frame, see RegisterActorTickFunctions
+	MeleeTickFunction.bCanEverTick = true;
+	MeleeTickFunction.bStartWithTickEnabled = false;
+	MeleeTickFunction.TickGroup = TG_PostPhysics;
 
-	AgroSphere = CreateDefaultSubobject<USphereComponent>(TEXT("AgroSphere"));
-	AgroSphere -> SetupAttachment(GetRootComponent());
 
-	AttackRangeSphere = CreateDefaultSubobject<USphereComponent>(TEXT("AttackRangeSphere"));
-	AttackRangeSphere -> SetupAttachment(GetRootComponent());
-
-	RightMeleeBox = CreateDefaultSubobject<UBoxComponent>(TEXT("RightMeleeBox"));
-	RightMeleeBox -> SetupAttachment(GetMesh(), "RightArmBone");
-	LeftMeleeBox = CreateDefaultSubobject<UBoxComponent>(TEXT("LeftMeleeBox"));
-	LeftMeleeBox -> SetupAttachment(GetMesh(), "LeftArmBone");
-	
 	GetCharacterMovement() -> MaxWalkSpeed = 500.f;
+
+	HitZoneBones.Add(FName("head"), EHitZone::EHZ_Head);
+	HitZoneDamageMultipliers.Add(EHitZone::EHZ_Head, 1.f);
+	HitZoneDamageMultipliers.Add(EHitZone::EHZ_Torso, 1.f);
+	HitZoneDamageMultipliers.Add(EHitZone::EHZ_Limbs, 1.f);
 }
 
 // Called when the game starts or when spawned
@@ -67,38 +78,114 @@ void AEnemy::BeginPlay()
 	
 	Health = MaxHealth; // Refill the health
 	HideHealthBar();
+	InitializeHitZoneTable();
 
-	// Getting Blackboard ready
-	const FVector WorldPatrolPointFirst = UKismetMathLibrary::TransformLocation(GetActorTransform(), PatrolPointFirst);
-	const FVector WorldPatrolPointSecond = UKismetMathLibrary::TransformLocation(GetActorTransform(), PatrolPointSecond);
-	EnemyController = Cast<AEnemyController>(GetController());
-	if(EnemyController)
+	if(UParticlePoolSubsystem* ParticlePool = GetWorld() -> GetSubsystem<UParticlePoolSubsystem>())
 	{
-		EnemyController -> GetBlackboardComponent() -> SetValueAsVector(TEXT("PatrolPointFirst"), WorldPatrolPointFirst);
-		EnemyController -> GetBlackboardComponent() -> SetValueAsVector(TEXT("PatrolPointSecond"), WorldPatrolPointSecond);
-		EnemyController -> GetBlackboardComponent() -> SetValueAsBool(TEXT("Dead"), false);
-		EnemyController -> RunBehaviorTree(BehaviorTree);
+		ParticlePool -> Prewarm(BulletImpactParticles);
 	}
 
+	EnemyController = Cast<AEnemyController>(GetController());
+	StartBehavior();
+
+	RegisterWithSubsystems();
+
 	// Setting up collision settings
-	AgroSphere -> OnComponentBeginOverlap.AddDynamic(this, &AEnemy::AgroSphereOverlapped);
-	AttackRangeSphere -> OnComponentBeginOverlap.AddDynamic(this, &AEnemy::AttackSphereOverlapped);
-	AttackRangeSphere -> OnComponentEndOverlap.AddDynamic(this, &AEnemy::AttackSphereOverlapEnd);
-	RightMeleeBox -> OnComponentBeginOverlap.AddDynamic(this, &AEnemy::RightMeleeBoxOverlapped);
-	LeftMeleeBox -> OnComponentBeginOverlap.AddDynamic(this, &AEnemy::LeftMeleeBoxOverlapped);
-	
 	GetMesh() -> SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
 	GetMesh() -> SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
 	GetCapsuleComponent() -> SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
-	RightMeleeBox -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	RightMeleeBox -> SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
-	RightMeleeBox -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-	RightMeleeBox -> SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
+}
+
+void FEnemyMeleeTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if(IsValid(Target) && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target -> TickMeleeSwings();
+	}
+}
+
+FString FEnemyMeleeTickFunction::DiagnosticMessage()
+{
+	return Target ? Target -> GetFullName() + TEXT("[TickMeleeSwings]") : TEXT("[TickMeleeSwings]");
+}
+
+void AEnemy::RegisterActorTickFunctions(bool bRegister)
+{
+	Super::RegisterActorTickFunctions(bRegister);
+
+	if(bRegister)
+	{
+		MeleeTickFunction.Target = this;
+		MeleeTickFunction.SetTickFunctionEnable(RightMeleeSwing.bActive || LeftMeleeSwing.bActive);
+		MeleeTickFunction.RegisterTickFunction(GetLevel());
+		// Sockets are only up to date once the mesh ticked
+		MeleeTickFunction.AddPrerequisite(GetMesh(), GetMesh() -> PrimaryComponentTick);
+	}
+	else if(MeleeTickFunction.IsTickFunctionRegistered())
+	{
+		MeleeTickFunction.UnRegisterTickFunction();
+	}
+}
+
+void AEnemy::TickMeleeSwings()
+{
+	if(RightMeleeSwing.bActive) TraceMeleeSwing(RightMeleeSwing);
+	if(LeftMeleeSwing.bActive) TraceMeleeSwing(LeftMeleeSwing);
+}
 
-	LeftMeleeBox -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	LeftMeleeBox -> SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
-	LeftMeleeBox -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-	LeftMeleeBox -> SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
+void AEnemy::StartBehavior()
+{
+	if(EnemyController == nullptr) return;
+
+	// Getting Blackboard ready
+	const FVector WorldPatrolPointFirst = UKismetMathLibrary::TransformLocation(GetActorTransform(), PatrolPointFirst);
+	const FVector WorldPatrolPointSecond = UKismetMathLibrary::TransformLocation(GetActorTransform(), PatrolPointSecond);
+	EnemyController -> SetBlackboardVector(EEnemyBlackboardKey::PatrolPointFirst, WorldPatrolPointFirst);
+	EnemyController -> SetBlackboardVector(EEnemyBlackboardKey::PatrolPointSecond, WorldPatrolPointSecond);
+	EnemyController -> SetBlackboardBool(EEnemyBlackboardKey::Dead, false);
+	EnemyController -> RunBehaviorTree(BehaviorTree);
+}
+
+void AEnemy::RegisterWithSubsystems()
+{
+	// Far away enemies tick, think and move at a lower rate
+	if(UEnemyLODSubsystem* EnemyLOD = GetWorld() -> GetSubsystem<UEnemyLODSubsystem>())
+	{
+		EnemyLOD -> RegisterEnemy(this);
+	}
+	if(UEnemyPerceptionSubsystem* EnemyPerception = GetWorld() -> GetSubsystem<UEnemyPerceptionSubsystem>())
+	{
+		EnemyPerception -> RegisterEnemy(this);
+	}
+	// Less significant enemies animate at a lower rate
+	if(UEnemyAnimBudgetSubsystem* EnemyAnimBudget = GetWorld() -> GetSubsystem<UEnemyAnimBudgetSubsystem>())
+	{
+		EnemyAnimBudget -> RegisterMesh(Cast<UEnemyMeshComponent>(GetMesh()));
+	}
+}
+
+void AEnemy::UnregisterFromSubsystems()
+{
+	if(UEnemyLODSubsystem* EnemyLOD = GetWorld() -> GetSubsystem<UEnemyLODSubsystem>())
+	{
+		EnemyLOD -> UnregisterEnemy(this);
+	}
+	if(UEnemyPerceptionSubsystem* EnemyPerception = GetWorld() -> GetSubsystem<UEnemyPerceptionSubsystem>())
+	{
+		EnemyPerception -> UnregisterEnemy(this);
+	}
+	if(UEnemyAnimBudgetSubsystem* EnemyAnimBudget = GetWorld() -> GetSubsystem<UEnemyAnimBudgetSubsystem>())
+	{
+		EnemyAnimBudget -> UnregisterMesh(Cast<UEnemyMeshComponent>(GetMesh()));
+	}
+}
+
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterFromSubsystems();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AEnemy::ShowHealthBar_Implementation()
@@ -113,6 +200,8 @@ void AEnemy::Die()
 	if(bDying) return;
 	bDying = true;
 	HideHealthBar();
+	// The death montage cuts the attack before its deactivate notify
+	CancelMeleeSwings();
 	UAnimInstance* AnimInstance = GetMesh() -> GetAnimInstance();
 	if(AnimInstance && DeathMontage)
 	{
@@ -120,7 +209,7 @@ void AEnemy::Die()
 	}
 	if(EnemyController)
 	{
-		EnemyController -> GetBlackboardComponent() -> SetValueAsBool(TEXT("Dead"), true);
+		EnemyController -> SetBlackboardBool(EEnemyBlackboardKey::Dead, true);
 		EnemyController -> StopMovement();
 	}
 }
@@ -128,12 +217,84 @@ void AEnemy::Die()
 void AEnemy::FinishDeath()
 {
 	GetMesh() -> bPauseAnims = true;
-	GetWorldTimerManager().SetTimer(DeathDestroyTimer, this, &AEnemy::DestroyEnemy, DeathDestroyDuration);
+	if(UCorpseManagerSubsystem* CorpseManager = GetWorld() -> GetSubsystem<UCorpseManagerSubsystem>())
+	{
+		// Stripped down to the frozen mesh, and evicted early when there are too many corpses
+		CorpseManager -> AddCorpse(this, DeathDestroyDuration);
+	}
+	else
+	{
+		GetWorldTimerManager().SetTimer(DeathDestroyTimer, this, &AEnemy::DestroyEnemy, DeathDestroyDuration);
+	}
 }
 
 void AEnemy::DestroyEnemy()
 {
-	Destroy();
+	// Kept with its controller for the next spawn of this class
+	UEnemyPoolSubsystem::ReleasePooledEnemy(this);
+}
+
+void AEnemy::OnReleasedToPool()
+{
+	// A pooled enemy is nothing more than a hidden corpse
+	BecomeCorpse();
+}
+
+void AEnemy::BecomeCorpse()
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	HideHealthBar();
+
+	if(EnemyController)
+	{
+		EnemyController -> StopMovement();
+		if(EnemyController -> GetBrainComponent())
+		{
+			EnemyController -> GetBrainComponent() -> StopLogic(TEXT("Released to pool"));
+		}
+	}
+	GetCharacterMovement() -> StopMovementImmediately();
+	GetCharacterMovement() -> DisableMovement();
+	CancelMeleeSwings();
+
+	UnregisterFromSubsystems();
+	SetActorTickEnabled(false);
+
+	// Only the frozen pose is left, nothing ticks or collides
+	GetCharacterMovement() -> SetComponentTickEnabled(false);
+	GetMesh() -> SetComponentTickEnabled(false);
+	GetCapsuleComponent() -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GetMesh() -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
+}
+
+void AEnemy::OnAcquiredFromPool()
+{
+	Health = MaxHealth;
+	bDying = false;
+	bStunned = false;
+	bInAttackRange = false;
+	bCanHitReact = true;
+
+	const AEnemy* DefaultEnemy = GetClass() -> GetDefaultObject<AEnemy>();
+	GetCapsuleComponent() -> SetCollisionEnabled(DefaultEnemy -> GetCapsuleComponent() -> GetCollisionEnabled());
+	GetMesh() -> SetCollisionEnabled(DefaultEnemy -> GetMesh() -> GetCollisionEnabled());
+	GetMesh() -> SetComponentTickEnabled(true);
+	GetMesh() -> bPauseAnims = false;
+	if(UAnimInstance* AnimInstance = GetMesh() -> GetAnimInstance())
+	{
+		AnimInstance -> StopAllMontages(0.f);
+	}
+	GetCharacterMovement() -> SetComponentTickEnabled(true);
+	GetCharacterMovement() -> SetMovementMode(MOVE_Walking);
+	GetCharacterMovement() -> MaxWalkSpeed = DefaultEnemy -> GetCharacterMovement() -> MaxWalkSpeed;
+	SetActorTickEnabled(true);
+
+	if(EnemyController)
+	{
+		EnemyController -> ResetBlackboard();
+	}
+	StartBehavior();
+	RegisterWithSubsystems();
 }
 
 void AEnemy::PlayHitMontage(FName Section, float PlayRate)
@@ -183,123 +344,116 @@ void AEnemy::ResetHitReactTimer()
 	bCanHitReact = true;
 }
 
-void AEnemy::DestroyHitNumberWidget(UUserWidget* HitNumberWidget)
+void AEnemy::StoreHitNumber(UUserWidget* HitNumberWidget, FVector Location)
 {
-	HitNumbers.Remove(HitNumberWidget);
-	HitNumberWidget -> RemoveFromParent();
+	UHitNumberManager::StoreWorldHitNumber(this, HitNumberWidget, Location);
 }
 
-void AEnemy::StoreHitNumber(UUserWidget* HitNumberWidget, FVector Location)
+void AEnemy::OnTargetSensed(AShooterCharacter* Target)
 {
-	HitNumbers.Add(HitNumberWidget, Location);
-
-	FTimerHandle HitNumberTimer;
-	FTimerDelegate HitNumberDelegate;
-	HitNumberDelegate.BindUFunction(this, FName("DestroyHitNumberWidget"), HitNumberWidget);
-
-	GetWorldTimerManager().SetTimer(HitNumberTimer, HitNumberDelegate, HitNumberDestroyTime, false);
+	if(!Target) return;
+	if(EnemyController)
+		EnemyController -> SetBlackboardObject(EEnemyBlackboardKey::Target, Target);
+	GetCharacterMovement() -> MaxWalkSpeed = 600.f;
 }
 
-void AEnemy::UpdateHitLocation()
+void AEnemy::SetStunned(bool Stunned)
 {
-	for(auto &HitPair : HitNumbers)
-	{
-		UUserWidget* HitNumber{ HitPair.Key };
-		const FVector HitLocation{ HitPair.Value };
-
-		FVector2D ScreenPosition;
-		UGameplayStatics::ProjectWorldToScreen(GetWorld() -> GetFirstPlayerController(), HitLocation, ScreenPosition);
-		HitNumber -> SetPositionInViewport(ScreenPosition);
-	}
+	bStunned = Stunned;
+	if(EnemyController)
+		EnemyController -> SetBlackboardBool(EEnemyBlackboardKey::Stunned, Stunned);
 }
 
-void AEnemy::AgroSphereOverlapped(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AEnemy::SetInAttackRange(bool bInRange)
 {
-	if(!OtherActor) return;
-	auto Character = Cast<AShooterCharacter>(OtherActor);
-	if(Character)
-	{
-		EnemyController -> GetBlackboardComponent() -> SetValueAsObject(TEXT("Target"), Character);
-		GetCharacterMovement() -> MaxWalkSpeed = 600.f;
-	}
+	bInAttackRange = bInRange;
+	if(EnemyController)
+		EnemyController -> SetBlackboardBool(EEnemyBlackboardKey::InAttackRange, bInRange);
 }
 
-void AEnemy::SetStunned(bool Stunned)
+void AEnemy::ActivateRightMeleeCollision()
 {
-	bStunned = Stunned;
-	if(EnemyController)
-		EnemyController -> GetBlackboardComponent() -> SetValueAsBool(TEXT("Stunned"), Stunned);
+	BeginMeleeSwing(RightMeleeSwing, RightMeleeTipSocketName);
 }
 
-void AEnemy::AttackSphereOverlapped(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AEnemy::DeactivateRightMeleeCollision()
 {
-	if(!OtherActor) return;
-	auto Character = Cast<AShooterCharacter>(OtherActor);
-	if(Character)
-	{
-		bInAttackRange = true;
-		if(EnemyController)
-			EnemyController -> GetBlackboardComponent() -> SetValueAsBool(TEXT("InAttackRange"), true);
-	}
+	EndMeleeSwing(RightMeleeSwing);
 }
 
-void AEnemy::AttackSphereOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+void AEnemy::ActivateLeftMeleeCollision()
 {
-	if(!OtherActor) return;
-	auto Character = Cast<AShooterCharacter>(OtherActor);
-	if(Character)
-	{
-		bInAttackRange = false;
-		if(EnemyController)
-			EnemyController -> GetBlackboardComponent() -> SetValueAsBool(TEXT("InAttackRange"), false);
-	}
+	BeginMeleeSwing(LeftMeleeSwing, LeftMeleeTipSocketName);
 }
 
-void AEnemy::RightMeleeBoxOverlapped(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AEnemy::DeactivateLeftMeleeCollision()
 {
-	auto Victim = Cast<AShooterCharacter>(OtherActor);
-	DoDamage(Victim);
-	SpawnBlood(Victim, RightMeleeTipSocketName);
+	EndMeleeSwing(LeftMeleeSwing);
 }
 
-void AEnemy::LeftMeleeBoxOverlapped(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AEnemy::BeginMeleeSwing(FMeleeSwing& Swing, FName SocketName)
 {
-	auto Victim = Cast<AShooterCharacter>(OtherActor);
-	DoDamage(Victim);
-	SpawnBlood(Victim, LeftMeleeTipSocketName);
+	Swing.SocketName = SocketName;
+	Swing.PreviousLocation = GetMesh() -> GetSocketLocation(SocketName);
+	Swing.HitActors.Reset();
+	Swing.bActive = true;
+	RefreshMeleeTickEnabled();
 }
 
-void AEnemy::ActivateRightMeleeCollision()
+void AEnemy::EndMeleeSwing(FMeleeSwing& Swing)
 {
-	RightMeleeBox -> SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	if(!Swing.bActive) return;
+
+	TraceMeleeSwing(Swing);
+	Swing.bActive = false;
+	Swing.HitActors.Reset();
+	RefreshMeleeTickEnabled();
 }
 
-void AEnemy::DeactivateRightMeleeCollision()
+void AEnemy::CancelMeleeSwings()
 {
-	RightMeleeBox -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RightMeleeSwing.bActive = false;
+	LeftMeleeSwing.bActive = false;
+	RefreshMeleeTickEnabled();
 }
 
-void AEnemy::ActivateLeftMeleeCollision()
+void AEnemy::RefreshMeleeTickEnabled()
 {
-	LeftMeleeBox -> SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	const bool bSwinging{ RightMeleeSwing.bActive || LeftMeleeSwing.bActive };
+	if(MeleeTickFunction.IsTickFunctionEnabled() != bSwinging)
+	{
+		MeleeTickFunction.SetTickFunctionEnable(bSwinging);
+	}
 }
 
-void AEnemy::DeactivateLeftMeleeCollision()
+void AEnemy::TraceMeleeSwing(FMeleeSwing& Swing)
 {
-	LeftMeleeBox -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	const FVector Location{ GetMesh() -> GetSocketLocation(Swing.SocketName) };
+
+	// A sweep covers the whole path since the last trace, fast swings at low frame rates can't skip the victim
+	TArray<FHitResult> Hits;
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(EnemyMeleeSweep), false, this);
+	GetWorld() -> SweepMultiByObjectType(Hits, Swing.PreviousLocation, Location, FQuat::Identity,
+		FCollisionObjectQueryParams(ECollisionChannel::ECC_Pawn), FCollisionShape::MakeSphere(MeleeTraceRadius), QueryParams);
+	Swing.PreviousLocation = Location;
+
+	for(const FHitResult& Hit : Hits)
+	{
+		AShooterCharacter* Victim = Cast<AShooterCharacter>(Hit.GetActor());
+		if(Victim == nullptr || Swing.HitActors.Contains(Victim)) continue;
+
+		Swing.HitActors.Add(Victim);
+		DoDamage(Victim);
+		SpawnBlood(Victim, Swing.SocketName);
+	}
 }
 
 void AEnemy::DoDamage(AShooterCharacter* Victim)
 {
 	if(!Victim) return;
-	UGameplayStatics::ApplyDamage(Victim, HitDamage, GetController(), this, UDamageType::StaticClass());
+	// Applied at the end of the frame, the victim rolls the stun when it takes the damage
+	UCombatDamageSubsystem::QueueWorldDamage(this, Victim, HitDamage, GetController(), this);
 	if(MeleeHitImpactSound) UGameplayStatics::PlaySoundAtLocation(this, MeleeHitImpactSound, Victim -> GetActorLocation());
-	StunVictim(Victim);
 }
 
 void AEnemy::SpawnBlood(AShooterCharacter* Victim, FName SocketName)
@@ -312,28 +466,57 @@ void AEnemy::SpawnBlood(AShooterCharacter* Victim, FName SocketName)
 			const FTransform SocketTransform{ TipSocket -> GetSocketTransform(GetMesh()) };
 			if(Victim -> GetBloodParticles())
 			{
-				UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), Victim -> GetBloodParticles(), SocketTransform);
+				UParticlePoolSubsystem::SpawnPooledEmitter(this, Victim -> GetBloodParticles(), SocketTransform);
 			}
 		}
 	}
 }
 
-void AEnemy::StunVictim(AShooterCharacter* Victim)
+void AEnemy::InitializeHitZoneTable()
 {
-	if(!Victim) return;
-	const float Chance{ FMath::FRandRange(0.f, 1.f) };
-	if(Chance <= Victim -> GetStunChance())
+	// Tables are shared between every enemy of the same class and mesh
+	HitZoneTable = UHitZoneSubsystem::FindOrBuildWorldTable(this, GetClass(), GetMesh(), HitZoneBones, HitZoneDamageMultipliers);
+}
+
+void AEnemy::ApplyLODTier(const FEnemyLODTier& Tier)
+{
+	SetActorTickInterval(Tier.ActorTickInterval);
+	if(EnemyController)
+	{
+		EnemyController -> SetBehaviorTreeTickInterval(Tier.BehaviorTreeTickInterval);
+	}
+
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	Movement -> SetComponentTickInterval(Tier.MovementTickInterval);
+	// Only swap between the ground modes, never interrupt falling
+	if(Tier.bNavWalking && Movement -> MovementMode == MOVE_Walking)
 	{
-		Victim -> Stun();
+		Movement -> SetMovementMode(MOVE_NavWalking);
 	}
+	else if(!Tier.bNavWalking && Movement -> MovementMode == MOVE_NavWalking)
+	{
+		Movement -> SetMovementMode(MOVE_Walking);
+	}
+
+	// The animation rate is up to the UEnemyAnimBudgetSubsystem, the tier only skips the pose of hidden meshes.
+	// Back to the blueprint's own option when the tier doesn't restrict it
+	GetMesh() -> VisibilityBasedAnimTickOption = Tier.bOnlyTickPoseWhenRendered
+		? EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered
+		: GetClass() -> GetDefaultObject<AEnemy>() -> GetMesh() -> VisibilityBasedAnimTickOption;
 }
 
-// Called every frame
-void AEnemy::Tick(float DeltaTime)
+EHitZone AEnemy::GetHitZone(const FHitResult& HitResult) const
 {
-	Super::Tick(DeltaTime);
+	if(!HitZoneTable.IsValid()) return EHitZone::EHZ_Torso;
 
-	UpdateHitLocation();
+	// Hits on the mesh carry the index of the physics body, no name lookup needed
+	EHitZone BodyZone;
+	if(HitResult.GetComponent() == GetMesh() && HitZoneTable -> GetBodyZone(HitResult.Item, BodyZone))
+	{
+		return BodyZone;
+	}
+	if(HitResult.BoneName.IsNone()) return EHitZone::EHZ_Torso;
+	return HitZoneTable -> GetZone(GetMesh() -> GetBoneIndex(HitResult.BoneName));
 }
 
 // Called to bind functionality to input
@@ -346,20 +529,27 @@ void AEnemy::BulletHit_Implementation(FHitResult HitResult)
 {
 	if(bDying) return;
 	
-	ShowHealthBar();
-	const float Stun = FMath::FRandRange(0.f, 1.f);
-	if(Stun <= StunChance)
-	{
-		PlayHitMontage(FName(HitSectionName));
-		SetStunned(true);
-	}
+	// Only the per-impact effects, the reaction comes once the merged damage is applied
 	if(ImpactSound)
 	{
 		UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation());
 	}
 	if(BulletImpactParticles)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), BulletImpactParticles, HitResult.Location, FRotator(0.f), true);
+		UParticlePoolSubsystem::SpawnPooledEmitter(this, BulletImpactParticles, FTransform(HitResult.Location));
+	}
+}
+
+void AEnemy::HitReact_Implementation(int32 HitCount)
+{
+	if(bDying) return;
+
+	ShowHealthBar();
+	const float Stun = FMath::FRandRange(0.f, 1.f);
+	if(Stun <= StunChance)
+	{
+		PlayHitMontage(FName(HitSectionName));
+		SetStunned(true);
 	}
 }
 
@@ -368,7 +558,7 @@ float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AC
 {
 	if(EnemyController)
 	{
-		EnemyController -> GetBlackboardComponent() -> SetValueAsObject(TEXT("Target"), DamageCauser);
+		EnemyController -> SetBlackboardObject(EEnemyBlackboardKey::Target, DamageCauser);
 	}
 	if(Health - DamageAmount <= 0.f)
 	{
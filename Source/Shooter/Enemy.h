@@ -4,23 +4,62 @@
 
 #include "CoreMinimal.h"
 #include "BulletHitInterface.h"
+#include "HitReactionInterface.h"
+#include "HitZone.h"
 #include "GameFramework/Character.h"
 
 #include "Enemy.generated.h"
 
+/** One hand's active melee window, its tip socket is swept from where it was on the previous trace */
+struct FMeleeSwing
+{
+	FName SocketName;
+
+	FVector PreviousLocation{ FVector::ZeroVector };
+
+	bool bActive{ false };
+
+	/** Victims already hit during this swing, each is damaged once per swing */
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<2>> HitActors;
+};
+
+/**
+ * Sweeps the enemy's open melee swings once the mesh was animated this frame, so the sockets aren't a frame late.
+ * Only enabled while a swing is open, and runs every frame whatever tick interval the LOD tier gave the actor.
+ */
+USTRUCT()
+struct FEnemyMeleeTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	class AEnemy* Target{ nullptr };
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+		const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FEnemyMeleeTickFunction> : public TStructOpsTypeTraitsBase2<FEnemyMeleeTickFunction>
+{
+	enum { WithCopy = false };
+};
+
 UCLASS()
-class SHOOTER_API AEnemy : public ACharacter, public IBulletHitInterface
+class SHOOTER_API AEnemy : public ACharacter, public IBulletHitInterface, public IHitReactionInterface
 {
 	GENERATED_BODY()
 
 public:
 	// Sets default values for this character's properties
-	AEnemy();
+	AEnemy(const FObjectInitializer& ObjectInitializer);
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION(BlueprintNativeEvent)
 	void ShowHealthBar();
 	void ShowHealthBar_Implementation();
@@ -45,37 +84,13 @@ protected:
 
 	void ResetHitReactTimer();
 
-	UFUNCTION()
-	void DestroyHitNumberWidget(UUserWidget* HitNumberWidget);
-
+	/** Hand a hit number widget created by the blueprint to the player's UHitNumberManager, which places and removes it */
 	UFUNCTION(BlueprintCallable)
-	void StoreHitNumber(UUserWidget* HitNumberWidget, FVector Location);
+	void StoreHitNumber(class UUserWidget* HitNumberWidget, FVector Location);
 
-	void UpdateHitLocation();
-
-	UFUNCTION()
-	void AgroSphereOverlapped(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex, bool bFromSweep, const FHitResult &SweepResult);
-		
 	UFUNCTION(BlueprintCallable)
 	void SetStunned(bool Stunned);
 
-	UFUNCTION()
-	void AttackSphereOverlapped(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex, bool bFromSweep, const FHitResult &SweepResult);
-
-	UFUNCTION()
-	void AttackSphereOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex);
-
-	UFUNCTION()
-	void RightMeleeBoxOverlapped(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex, bool bFromSweep, const FHitResult &SweepResult);
-
-	UFUNCTION()
-	void LeftMeleeBoxOverlapped(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex, bool bFromSweep, const FHitResult &SweepResult);
-
 	UFUNCTION(BlueprintCallable)
 	void ActivateRightMeleeCollision();
 	UFUNCTION(BlueprintCallable)
@@ -85,11 +100,36 @@ protected:
 	UFUNCTION(BlueprintCallable)
 	void DeactivateLeftMeleeCollision();
 
+	void BeginMeleeSwing(FMeleeSwing& Swing, FName SocketName);
+
+	/** Trace the rest of the swing and close its window */
+	void EndMeleeSwing(FMeleeSwing& Swing);
+
+	/** Close both swings without tracing them, e.g. when the attack is cut short */
+	void CancelMeleeSwings();
+
+	/** Enable the melee tick function only while a swing is open */
+	void RefreshMeleeTickEnabled();
+
+	virtual void RegisterActorTickFunctions(bool bRegister) override;
+
+	/** Sweep a sphere along the tip socket's path since the previous trace, damaging each new victim */
+	void TraceMeleeSwing(FMeleeSwing& Swing);
+
 	void DoDamage(class AShooterCharacter* Victim);
 
 	void SpawnBlood(AShooterCharacter* Victim, FName SocketName);
 
-	void StunVictim(AShooterCharacter* Victim);
+	/** Find the hit zone table shared by every enemy of this class in the UHitZoneSubsystem */
+	void InitializeHitZoneTable();
+
+	/** Write the patrol points to the blackboard and run the behavior tree */
+	void StartBehavior();
+
+	/** Hand the enemy to the LOD, perception and animation budget subsystems */
+	void RegisterWithSubsystems();
+
+	void UnregisterFromSubsystems();
 	
 private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
@@ -107,8 +147,16 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	float HitDamage;
 
+	/** Hit zone of the listed bones, bones not listed inherit the zone of their closest listed parent */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
+	TMap<FName, EHitZone> HitZoneBones;
+
+	/** Multiplier applied to the weapon damage for each hit zone */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
-	FString HeadBone;
+	TMap<EHitZone, float> HitZoneDamageMultipliers;
+
+	/** Lookup built from HitZoneBones, shared by every enemy of the same class and mesh */
+	TSharedPtr<const FHitZoneTable> HitZoneTable;
 
 	FTimerHandle HealthBarTimer;
 	
@@ -134,11 +182,6 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	float HitReactDurationMax;
 
-	TMap<UUserWidget*, FVector> HitNumbers;
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
-	float HitNumberDestroyTime;
-
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	UAnimMontage* AttackMontage;
 
@@ -160,6 +203,16 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
 	FName LeftMeleeTipSocketName;
 
+	/** Radius of the sphere swept along the melee tip sockets */
+	UPROPERTY(EditDefaultsOnly, Category = "Combat")
+	float MeleeTraceRadius;
+
+	FMeleeSwing RightMeleeSwing;
+
+	FMeleeSwing LeftMeleeSwing;
+
+	FEnemyMeleeTickFunction MeleeTickFunction;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
 	UAnimMontage* DeathMontage;
 
@@ -168,6 +221,7 @@ private:
 
 	FTimerHandle DeathDestroyTimer;
 
+	/** How long the corpse lies around, unless the UCorpseManagerSubsystem evicts it earlier */
 	UPROPERTY(EditDefaultsOnly, Category = "Combat")
 	float DeathDestroyDuration;
 	
@@ -183,8 +237,9 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI", meta = (AllowPrivateAccess = "true", MakeEditWidget = "true"))
 	FVector PatrolPointSecond;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Combat", meta = (AllowPrivateAccess = "true"))
-	class USphereComponent* AgroSphere;
+	/** Players closer than this become the target, sensed by the UEnemyPerceptionSubsystem. Replaces the AgroSphere radius */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float AgroRadius;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	bool bStunned;
@@ -195,29 +250,56 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	bool bInAttackRange;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
-	USphereComponent* AttackRangeSphere;
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
-	class UBoxComponent* RightMeleeBox;
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
-	UBoxComponent* LeftMeleeBox;
+	/** Players closer than this can be attacked, sensed by the UEnemyPerceptionSubsystem. Replaces the AttackRangeSphere radius */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float AttackRangeRadius;
 	
 public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 	virtual void BulletHit_Implementation(FHitResult HitResult) override;
 
+	/** Show the health bar and roll the stun once for all the hits merged this frame */
+	virtual void HitReact_Implementation(int32 HitCount) override;
+
 	virtual float TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 
-	FORCEINLINE FString GetHeadBone() const { return HeadBone; }
+	/** Hit zone of the body or bone hit by a trace */
+	EHitZone GetHitZone(const FHitResult& HitResult) const;
+
+	FORCEINLINE float GetHitZoneDamageMultiplier(EHitZone Zone) const
+	{
+		return HitZoneTable.IsValid() ? HitZoneTable -> GetDamageMultiplier(Zone) : 1.f;
+	}
 	FORCEINLINE UBehaviorTree* GetBehaviorTree() const { return BehaviorTree; }
-	
+
+	/** Throttle ticking, AI and movement to the LOD tier, called by the UEnemyLODSubsystem */
+	void ApplyLODTier(const struct FEnemyLODTier& Tier);
+
+	/** Stop the AI, movement and timers, called by the UEnemyPoolSubsystem when the enemy goes back to the pool */
+	void OnReleasedToPool();
+
+	/** Strip the dead enemy down to its frozen mesh, no AI, ticks or collision, called by the UCorpseManagerSubsystem */
+	void BecomeCorpse();
+
+	/** Reset to full health and restart the AI, called by the UEnemyPoolSubsystem when the enemy is spawned from the pool */
+	void OnAcquiredFromPool();
+
+	FORCEINLINE bool IsDying() const { return bDying; }
+	FORCEINLINE float GetAgroRadius() const { return AgroRadius; }
+	FORCEINLINE float GetAttackRangeRadius() const { return AttackRangeRadius; }
+
+	/** A player came into agro range, called by the UEnemyPerceptionSubsystem */
+	void OnTargetSensed(AShooterCharacter* Target);
+
+	/** A player entered or left the attack range, called by the UEnemyPerceptionSubsystem */
+	void SetInAttackRange(bool bInRange);
+
+	/** Sweep the open melee swings, called by the MeleeTickFunction */
+	void TickMeleeSwings();
+
+	/** Create a hit number widget in blueprint, only used while the UHitNumberManager has no widget class */
 	UFUNCTION(BlueprintImplementableEvent)
 	void ShowHitNumber(int32 Damage, FVector HitLocation, bool bHeadShot);
 };
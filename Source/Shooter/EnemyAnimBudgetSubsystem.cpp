@@ -0,0 +1,161 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "EnemyAnimBudgetSubsystem.h"
+
+#include "Shooter.h"
+#include "EnemyMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Anim Budget"), STAT_EnemyAnimBudget, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Anim Updates"), STAT_EnemyAnimUpdates, STATGROUP_Shooter);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Enemy Anim Estimated Game Thread Cost (ms)"), STAT_EnemyAnimEstimatedCost, STATGROUP_Shooter);
+
+void UEnemyAnimBudgetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UEnemyAnimBudgetSubsystem::OnWorldPreActorTick);
+}
+
+void UEnemyAnimBudgetSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	Entries.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEnemyAnimBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyAnimBudgetSubsystem::RegisterMesh(UEnemyMeshComponent* Mesh)
+{
+	if(Mesh == nullptr) return;
+	for(const FEnemyAnimBudgetEntry& Entry : Entries)
+	{
+		if(Entry.Mesh == Mesh) return;
+	}
+
+	FEnemyAnimBudgetEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Mesh = Mesh;
+	Entry.EstimatedCostMs = DefaultCostMs;
+	Mesh -> EnableExternalTickRateControl(true);
+}
+
+void UEnemyAnimBudgetSubsystem::UnregisterMesh(UEnemyMeshComponent* Mesh)
+{
+	for(int32 i = 0; i < Entries.Num(); i++)
+	{
+		if(Entries[i].Mesh == Mesh)
+		{
+			Mesh -> EnableExternalTickRateControl(false);
+			Mesh -> EnableExternalUpdate(true);
+			Mesh -> EnableExternalInterpolation(false);
+			Entries.RemoveAtSwap(i);
+			return;
+		}
+	}
+}
+
+void UEnemyAnimBudgetSubsystem::OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	// The delegate is shared by every world, only handle our own
+	if(World != GetWorld() || Entries.Num() == 0) return;
+
+	const APlayerController* PlayerController = World -> GetFirstPlayerController();
+	if(PlayerController == nullptr) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_EnemyAnimBudget);
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController -> GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	// Destroyed without unregistering
+	Entries.RemoveAllSwap([](const FEnemyAnimBudgetEntry& Entry) { return !IsValid(Entry.Mesh); });
+
+	for(FEnemyAnimBudgetEntry& Entry : Entries)
+	{
+		UpdateSignificance(Entry, ViewLocation);
+	}
+	AllocateBudget();
+	for(FEnemyAnimBudgetEntry& Entry : Entries)
+	{
+		ApplyTickRate(Entry, DeltaSeconds);
+	}
+}
+
+void UEnemyAnimBudgetSubsystem::UpdateSignificance(FEnemyAnimBudgetEntry& Entry, const FVector& ViewLocation)
+{
+	// Only frames that updated tell how much an update costs
+	if(Entry.bUpdatedLastFrame)
+	{
+		Entry.EstimatedCostMs = FMath::Lerp(Entry.EstimatedCostMs, Entry.Mesh -> GetLastGameThreadTimeMs(), CostSmoothing);
+	}
+
+	const float Distance{ static_cast<float>(FVector::Dist(ViewLocation, Entry.Mesh -> GetComponentLocation())) };
+	Entry.Significance = 1.f - FMath::Clamp(Distance / MaxSignificanceDistance, 0.f, 1.f);
+
+	const bool bRendered{ Entry.Mesh -> WasRecentlyRendered(0.2f) };
+	if(!bRendered && Distance > AlwaysSignificantDistance)
+	{
+		Entry.Significance *= OffscreenSignificanceScale;
+	}
+	// Nobody sees the skipped frames of a hidden mesh
+	Entry.bInterpolate = bRendered;
+}
+
+void UEnemyAnimBudgetSubsystem::AllocateBudget()
+{
+	Entries.Sort([](const FEnemyAnimBudgetEntry& A, const FEnemyAnimBudgetEntry& B)
+	{
+		return A.Significance > B.Significance;
+	});
+
+	float SpentMs{ 0.f };
+	for(FEnemyAnimBudgetEntry& Entry : Entries)
+	{
+		int32 TickRate{ 1 };
+		if(Entry.Significance <= 0.f) // Too far to matter, spend as little as possible on it
+		{
+			TickRate = MaxTickRate;
+		}
+		else
+		{
+			// Fastest rate that still fits what's left of the budget, averaged over the frames
+			while(TickRate < MaxTickRate && SpentMs + Entry.EstimatedCostMs / TickRate > GameThreadBudgetMs) TickRate++;
+		}
+
+		Entry.TickRate = FMath::Max(TickRate, 1);
+		SpentMs += Entry.EstimatedCostMs / Entry.TickRate;
+	}
+	SET_FLOAT_STAT(STAT_EnemyAnimEstimatedCost, SpentMs);
+}
+
+void UEnemyAnimBudgetSubsystem::ApplyTickRate(FEnemyAnimBudgetEntry& Entry, float DeltaSeconds)
+{
+	Entry.AccumulatedDeltaTime += DeltaSeconds;
+	Entry.FramesSinceUpdate++;
+
+	const bool bUpdate{ Entry.FramesSinceUpdate >= Entry.TickRate };
+	UEnemyMeshComponent* Mesh = Entry.Mesh;
+	Mesh -> SetExternalTickRate(static_cast<uint8>(FMath::Clamp(Entry.TickRate, 1, 255)));
+	Mesh -> EnableExternalUpdate(bUpdate);
+	Mesh -> EnableExternalInterpolation(Entry.bInterpolate && Entry.TickRate > 1);
+	if(bUpdate)
+	{
+		Mesh -> SetExternalDeltaTime(Entry.AccumulatedDeltaTime);
+		Entry.AccumulatedDeltaTime = 0.f;
+		Entry.FramesSinceUpdate = 0;
+		INC_DWORD_STAT(STAT_EnemyAnimUpdates);
+	}
+	else
+	{
+		// Fraction of the way from the pose shown to the last evaluated one
+		Mesh -> SetExternalInterpolationAlpha(static_cast<float>(Entry.FramesSinceUpdate) / Entry.TickRate);
+	}
+	Entry.bUpdatedLastFrame = bUpdate;
+}
@@ -0,0 +1,107 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyAnimBudgetSubsystem.generated.h"
+
+class UEnemyMeshComponent;
+
+/** Animation budget state of a registered enemy mesh */
+USTRUCT()
+struct FEnemyAnimBudgetEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UEnemyMeshComponent* Mesh{ nullptr };
+
+	/** 1 for the most important enemies, down to 0 for far away or hidden ones */
+	float Significance{ 0.f };
+
+	/** Smoothed game thread cost of one animation update in milliseconds */
+	float EstimatedCostMs{ 0.f };
+
+	/** The mesh evaluates once every TickRate frames */
+	int32 TickRate{ 1 };
+
+	int32 FramesSinceUpdate{ 0 };
+
+	/** Time passed since the last update, handed to the next one */
+	float AccumulatedDeltaTime{ 0.f };
+
+	/** Blend toward the last evaluated pose on skipped frames */
+	bool bInterpolate{ false };
+
+	bool bUpdatedLastFrame{ false };
+};
+
+/**
+ * Shares a per-frame game thread animation budget between every enemy mesh. Meshes are ranked by significance (distance to the
+ * view and whether they're on screen), the most significant ones update every frame, and the rest update less often
+ * with their skipped frames interpolated, so the game thread animation cost stays within the budget however large the horde.
+ * Off-screen meshes get what's left of the budget, meshes out of significance range only update at the lowest rate.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UEnemyAnimBudgetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Hand the mesh's update rate over to the budget */
+	void RegisterMesh(UEnemyMeshComponent* Mesh);
+
+	/** Give the mesh its own update rate back */
+	void UnregisterMesh(UEnemyMeshComponent* Mesh);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void UpdateSignificance(FEnemyAnimBudgetEntry& Entry, const FVector& ViewLocation);
+
+	/** Pick each entry's tick rate in order of significance, so the estimated cost fits the budget */
+	void AllocateBudget();
+
+	/** Tell the mesh whether to update this frame, or how far to interpolate */
+	void ApplyTickRate(FEnemyAnimBudgetEntry& Entry, float DeltaSeconds);
+
+	FDelegateHandle PreActorTickHandle;
+
+	UPROPERTY()
+	TArray<FEnemyAnimBudgetEntry> Entries;
+
+	/** Game thread milliseconds of animation updates per frame shared by every enemy. Parallel evaluation on worker threads isn't counted */
+	UPROPERTY(Config)
+	float GameThreadBudgetMs{ 1.5f };
+
+	/** Lowest update rate, in frames between two updates */
+	UPROPERTY(Config)
+	int32 MaxTickRate{ 10 };
+
+	/** Meshes farther than this have no significance */
+	UPROPERTY(Config)
+	float MaxSignificanceDistance{ 8000.f };
+
+	/** Off-screen meshes closer than this keep their significance, they may be about to hit the player */
+	UPROPERTY(Config)
+	float AlwaysSignificantDistance{ 1500.f };
+
+	/** Significance multiplier for meshes that weren't rendered recently */
+	UPROPERTY(Config)
+	float OffscreenSignificanceScale{ 0.1f };
+
+	/** Cost of a mesh that hasn't been measured yet */
+	UPROPERTY(Config)
+	float DefaultCostMs{ 0.1f };
+
+	/** Weight of the newest measurement in the smoothed cost */
+	UPROPERTY(Config)
+	float CostSmoothing{ 0.1f };
+};
@@ -0,0 +1,20 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "EnemyBehaviorTreeComponent.h"
+
+void UEnemyBehaviorTreeComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	AccumulatedDeltaTime += DeltaTime;
+	if(AccumulatedDeltaTime < LODTickInterval) return;
+
+	const float TreeDeltaTime{ AccumulatedDeltaTime };
+	AccumulatedDeltaTime = 0.f;
+	Super::TickComponent(TreeDeltaTime, TickType, ThisTickFunction);
+}
+
+void UEnemyBehaviorTreeComponent::SetLODTickInterval(float Interval)
+{
+	LODTickInterval = FMath::Max(Interval, 0.f);
+}
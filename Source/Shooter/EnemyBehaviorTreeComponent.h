@@ -0,0 +1,29 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "EnemyBehaviorTreeComponent.generated.h"
+
+/**
+ * Behavior tree component whose updates can be throttled by the enemy's AI LOD.
+ * Ticks are accumulated until the LOD interval has passed, then run once with the summed delta time.
+ */
+UCLASS()
+class SHOOTER_API UEnemyBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+
+	/** Minimum time between two behavior tree updates, 0 updates whenever the tree asks to */
+	void SetLODTickInterval(float Interval);
+
+private:
+	float LODTickInterval{ 0.f };
+
+	/** Time passed since the tree last updated */
+	float AccumulatedDeltaTime{ 0.f };
+};
@@ -2,18 +2,43 @@
 
 
 #include "EnemyController.h"
+#include "EnemyBehaviorTreeComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
-#include "BehaviorTree/BehaviorTreeComponent.h"
 #include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "Enemy.h"
 
+namespace EnemyBlackboard
+{
+	/** Names of the EEnemyBlackboardKey keys in the blackboard asset */
+	static const FName KeyNames[static_cast<uint8>(EEnemyBlackboardKey::Max)]
+	{
+		TEXT("Target"),
+		TEXT("TargetIsDead"),
+		TEXT("Dead"),
+		TEXT("Stunned"),
+		TEXT("InAttackRange"),
+		TEXT("PatrolPointFirst"),
+		TEXT("PatrolPointSecond")
+	};
+}
+
 AEnemyController::AEnemyController()
 {
+	for(FBlackboard::FKey& KeyID : BlackboardKeyIDs)
+	{
+		KeyID = FBlackboard::InvalidKey;
+	}
+
 	BlackboardComponent = CreateDefaultSubobject<UBlackboardComponent>(TEXT("Blackboard Component"));
 	check(BlackboardComponent);
 
-	BehaviorTreeComponent = CreateDefaultSubobject<UBehaviorTreeComponent>(TEXT("BehaviorTree Component"));
+	BehaviorTreeComponent = CreateDefaultSubobject<UEnemyBehaviorTreeComponent>(TEXT("BehaviorTree Component"));
 	check(BehaviorTreeComponent);
+	// RunBehaviorTree reuses the brain component instead of creating its own
+	BrainComponent = BehaviorTreeComponent;
 }
 
 void AEnemyController::OnPossess(APawn* InPawn)
@@ -27,6 +52,60 @@ void AEnemyController::OnPossess(APawn* InPawn)
 		if(Enemy -> GetBehaviorTree())
 		{
 			BlackboardComponent -> InitializeBlackboard(*Enemy -> GetBehaviorTree() -> BlackboardAsset);
+			CacheBlackboardKeyIDs();
 		}
 	}
 }
+
+void AEnemyController::SetBehaviorTreeTickInterval(float Interval)
+{
+	BehaviorTreeComponent -> SetLODTickInterval(Interval);
+}
+
+void AEnemyController::CacheBlackboardKeyIDs()
+{
+	for(uint8 i = 0; i < static_cast<uint8>(EEnemyBlackboardKey::Max); i++)
+	{
+		BlackboardKeyIDs[i] = BlackboardComponent -> GetKeyID(EnemyBlackboard::KeyNames[i]);
+	}
+}
+
+void AEnemyController::ResetBlackboard()
+{
+	if(BlackboardComponent == nullptr) return;
+
+	// Every key of the asset, not only the cached ones, blueprint tasks may have written any of them
+	for(int32 KeyIndex = 0; KeyIndex < BlackboardComponent -> GetNumKeys(); KeyIndex++)
+	{
+		const FBlackboard::FKey KeyID(KeyIndex);
+		if(BlackboardComponent -> GetKeyName(KeyID) == FBlackboard::KeySelf) continue; // Still the same pawn
+		BlackboardComponent -> ClearValue(KeyID);
+	}
+}
+
+void AEnemyController::SetBlackboardBool(EEnemyBlackboardKey Key, bool bValue)
+{
+	const FBlackboard::FKey KeyID{ GetBlackboardKeyID(Key) };
+	if(KeyID == FBlackboard::InvalidKey) return;
+	if(BlackboardComponent -> GetValue<UBlackboardKeyType_Bool>(KeyID) == bValue) return;
+
+	BlackboardComponent -> SetValue<UBlackboardKeyType_Bool>(KeyID, bValue);
+}
+
+void AEnemyController::SetBlackboardObject(EEnemyBlackboardKey Key, UObject* Value)
+{
+	const FBlackboard::FKey KeyID{ GetBlackboardKeyID(Key) };
+	if(KeyID == FBlackboard::InvalidKey) return;
+	if(BlackboardComponent -> GetValue<UBlackboardKeyType_Object>(KeyID) == Value) return;
+
+	BlackboardComponent -> SetValue<UBlackboardKeyType_Object>(KeyID, Value);
+}
+
+void AEnemyController::SetBlackboardVector(EEnemyBlackboardKey Key, const FVector& Value)
+{
+	const FBlackboard::FKey KeyID{ GetBlackboardKeyID(Key) };
+	if(KeyID == FBlackboard::InvalidKey) return;
+	if(BlackboardComponent -> GetValue<UBlackboardKeyType_Vector>(KeyID) == Value) return;
+
+	BlackboardComponent -> SetValue<UBlackboardKeyType_Vector>(KeyID, Value);
+}
@@ -4,8 +4,23 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 #include "EnemyController.generated.h"
 
+/** Blackboard keys written from code, their IDs are resolved once per possession */
+enum class EEnemyBlackboardKey : uint8
+{
+	Target,
+	TargetIsDead,
+	Dead,
+	Stunned,
+	InAttackRange,
+	PatrolPointFirst,
+	PatrolPointSecond,
+
+	Max
+};
+
 UCLASS()
 class SHOOTER_API AEnemyController : public AAIController
 {
@@ -16,14 +31,36 @@ public:
 
 	virtual void OnPossess(APawn* InPawn) override;
 
+	/** Minimum time between two behavior tree updates, set by the enemy's LOD tier */
+	void SetBehaviorTreeTickInterval(float Interval);
+
+	/** Typed blackboard writes through the cached key IDs, unchanged values are skipped */
+	void SetBlackboardBool(EEnemyBlackboardKey Key, bool bValue);
+	void SetBlackboardObject(EEnemyBlackboardKey Key, UObject* Value);
+	void SetBlackboardVector(EEnemyBlackboardKey Key, const FVector& Value);
+
+	/** Clear every key of the blackboard but SelfActor, so a pooled enemy starts over with a fresh blackboard */
+	void ResetBlackboard();
+
+private:
+	/** Look up the IDs of every EEnemyBlackboardKey in the current blackboard asset */
+	void CacheBlackboardKeyIDs();
+
 private:
 	UPROPERTY(EditDefaultsOnly, Category = "AI", meta = (AllowPrivateAccess = "true"))
 	class UBlackboardComponent* BlackboardComponent;
 
 	UPROPERTY(EditDefaultsOnly, Category = "AI", meta = (AllowPrivateAccess = "true"))
-	class UBehaviorTreeComponent* BehaviorTreeComponent;
+	class UEnemyBehaviorTreeComponent* BehaviorTreeComponent;
+
+	/** Key ID of each EEnemyBlackboardKey, InvalidKey if the blackboard doesn't have it */
+	FBlackboard::FKey BlackboardKeyIDs[static_cast<uint8>(EEnemyBlackboardKey::Max)];
 	
 public:
 	FORCEINLINE UBlackboardComponent* GetBlackboardComponent() const { return BlackboardComponent; }
+	FORCEINLINE FBlackboard::FKey GetBlackboardKeyID(EEnemyBlackboardKey Key) const
+	{
+		return BlackboardKeyIDs[static_cast<uint8>(Key)];
+	}
 	
 };
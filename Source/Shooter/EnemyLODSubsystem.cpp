@@ -0,0 +1,158 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "EnemyLODSubsystem.h"
+
+#include "Shooter.h"
+#include "Enemy.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy LOD Update"), STAT_EnemyLODUpdate, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy LOD Changes"), STAT_EnemyLODChanges, STATGROUP_Shooter);
+
+namespace EnemyLOD
+{
+	static FEnemyLODTier MakeTier(float MaxDistance, float ActorTickInterval, float BehaviorTreeTickInterval,
+		float MovementTickInterval, bool bNavWalking, bool bOnlyTickPoseWhenRendered)
+	{
+		FEnemyLODTier Tier;
+		Tier.MaxDistance = MaxDistance;
+		Tier.ActorTickInterval = ActorTickInterval;
+		Tier.BehaviorTreeTickInterval = BehaviorTreeTickInterval;
+		Tier.MovementTickInterval = MovementTickInterval;
+		Tier.bNavWalking = bNavWalking;
+		Tier.bOnlyTickPoseWhenRendered = bOnlyTickPoseWhenRendered;
+		return Tier;
+	}
+}
+
+void UEnemyLODSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if(Tiers.Num() == 0) // Nothing in the config, use the defaults
+	{
+		Tiers.Add(EnemyLOD::MakeTier(1500.f, 0.f, 0.f, 0.f, false, false));
+		Tiers.Add(EnemyLOD::MakeTier(4000.f, 0.1f, 0.1f, 0.033f, false, false));
+		Tiers.Add(EnemyLOD::MakeTier(8000.f, 0.25f, 0.25f, 0.1f, false, true));
+		Tiers.Add(EnemyLOD::MakeTier(MAX_flt, 0.5f, 0.5f, 0.25f, false, true));
+	}
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UEnemyLODSubsystem::OnWorldPreActorTick);
+}
+
+void UEnemyLODSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	Entries.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEnemyLODSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyLODSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if(Enemy == nullptr) return;
+	for(const FEnemyLODEntry& Entry : Entries)
+	{
+		if(Entry.Enemy == Enemy) return;
+	}
+
+	FEnemyLODEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Enemy = Enemy;
+
+	const APlayerController* PlayerController = GetWorld() -> GetFirstPlayerController();
+	if(PlayerController == nullptr) return; // Picked up by the next update
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController -> GetPlayerViewPoint(ViewLocation, ViewRotation);
+	UpdateEntry(Entry, ViewLocation);
+}
+
+void UEnemyLODSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	for(int32 i = 0; i < Entries.Num(); i++)
+	{
+		if(Entries[i].Enemy == Enemy)
+		{
+			Entries.RemoveAtSwap(i);
+			return;
+		}
+	}
+}
+
+void UEnemyLODSubsystem::OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	// The delegate is shared by every world, only handle our own
+	if(World != GetWorld() || Entries.Num() == 0 || Tiers.Num() == 0) return;
+
+	const APlayerController* PlayerController = World -> GetFirstPlayerController();
+	if(PlayerController == nullptr) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_EnemyLODUpdate);
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController -> GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	// Round robin over the entries, a slice of them per frame
+	const int32 NumUpdates{ FMath::Min(MaxUpdatesPerFrame, Entries.Num()) };
+	for(int32 i = 0; i < NumUpdates; i++)
+	{
+		if(NextEntryIndex >= Entries.Num()) NextEntryIndex = 0;
+
+		if(!IsValid(Entries[NextEntryIndex].Enemy)) // Destroyed without unregistering
+		{
+			Entries.RemoveAtSwap(NextEntryIndex);
+			if(Entries.Num() == 0) return;
+			continue;
+		}
+		UpdateEntry(Entries[NextEntryIndex], ViewLocation);
+		NextEntryIndex++;
+	}
+}
+
+void UEnemyLODSubsystem::UpdateEntry(FEnemyLODEntry& Entry, const FVector& ViewLocation)
+{
+	const float Distance{ static_cast<float>(FVector::Dist(ViewLocation, Entry.Enemy -> GetActorLocation())) };
+	Entry.DistanceTier = ComputeDistanceTier(Distance, Entry.DistanceTier);
+
+	int32 Tier{ Entry.DistanceTier };
+	if(Tier > 0 && !Entry.Enemy -> WasRecentlyRendered(0.2f))
+	{
+		Tier = FMath::Min(Tier + OffscreenTierBias, Tiers.Num() - 1);
+	}
+
+	if(Tier == Entry.AppliedTier) return;
+	Entry.AppliedTier = Tier;
+	Entry.Enemy -> ApplyLODTier(Tiers[Tier]);
+	INC_DWORD_STAT(STAT_EnemyLODChanges);
+}
+
+int32 UEnemyLODSubsystem::ComputeDistanceTier(float Distance, int32 CurrentTier) const
+{
+	const int32 LastTier{ Tiers.Num() - 1 };
+	if(CurrentTier == INDEX_NONE) // First evaluation, jump straight to the tier
+	{
+		int32 Tier{ 0 };
+		while(Tier < LastTier && Distance > Tiers[Tier].MaxDistance) Tier++;
+		return Tier;
+	}
+
+	// Step one tier at a time, and only once past the border by the hysteresis distance
+	CurrentTier = FMath::Min(CurrentTier, LastTier);
+	if(CurrentTier < LastTier && Distance > Tiers[CurrentTier].MaxDistance + HysteresisDistance)
+	{
+		return CurrentTier + 1;
+	}
+	if(CurrentTier > 0 && Distance < Tiers[CurrentTier - 1].MaxDistance - HysteresisDistance)
+	{
+		return CurrentTier - 1;
+	}
+	return CurrentTier;
+}
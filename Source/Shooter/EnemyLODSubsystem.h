@@ -0,0 +1,114 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyLODSubsystem.generated.h"
+
+class AEnemy;
+
+/** How much work an enemy does per frame within a distance band from the player */
+USTRUCT()
+struct FEnemyLODTier
+{
+	GENERATED_BODY()
+
+	/** Enemies closer to the player than this belong to the tier */
+	UPROPERTY(EditAnywhere)
+	float MaxDistance{ 0.f };
+
+	UPROPERTY(EditAnywhere)
+	float ActorTickInterval{ 0.f };
+
+	/** Minimum time between two behavior tree updates */
+	UPROPERTY(EditAnywhere)
+	float BehaviorTreeTickInterval{ 0.f };
+
+	UPROPERTY(EditAnywhere)
+	float MovementTickInterval{ 0.f };
+
+	/**
+	 * Move along the navmesh instead of sweeping for the floor, opt-in per tier.
+	 * Saves the floor sweeps, but the capsule no longer collides with the world, the enemy follows the navmesh
+	 * height rather than the real floor and can't step on physics objects or dynamic obstacles missing from the navmesh.
+	 */
+	UPROPERTY(EditAnywhere)
+	bool bNavWalking{ false };
+
+	/** Skip the pose update while the mesh isn't rendered */
+	UPROPERTY(EditAnywhere)
+	bool bOnlyTickPoseWhenRendered{ false };
+};
+
+/** LOD state of a registered enemy */
+USTRUCT()
+struct FEnemyLODEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AEnemy* Enemy{ nullptr };
+
+	/** Tier from distance alone, before the off-screen bias */
+	int32 DistanceTier{ INDEX_NONE };
+
+	/** Tier currently applied to the enemy */
+	int32 AppliedTier{ INDEX_NONE };
+};
+
+/**
+ * Sorts enemies into LOD tiers by distance to the player and whether they were rendered,
+ * and throttles their actor, behavior tree and movement ticks accordingly. Animation rates are up to the UEnemyAnimBudgetSubsystem.
+ * Only a fixed number of enemies is re-evaluated per frame, so the cost stays flat with the enemy count.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UEnemyLODSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Start managing the enemy's LOD, its tier gets applied right away */
+	void RegisterEnemy(AEnemy* Enemy);
+
+	void UnregisterEnemy(AEnemy* Enemy);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Re-evaluate the entry's tier and apply it if it changed */
+	void UpdateEntry(FEnemyLODEntry& Entry, const FVector& ViewLocation);
+
+	/** Tier for the distance, moving at most one tier away from the current one */
+	int32 ComputeDistanceTier(float Distance, int32 CurrentTier) const;
+
+	FDelegateHandle PreActorTickHandle;
+
+	UPROPERTY()
+	TArray<FEnemyLODEntry> Entries;
+
+	/** Entry the next update starts from */
+	int32 NextEntryIndex{ 0 };
+
+	/** Tiers from closest to farthest, the last one covers every distance beyond */
+	UPROPERTY(Config)
+	TArray<FEnemyLODTier> Tiers;
+
+	/** How far past a tier border an enemy has to go before switching tiers, so it doesn't flicker on the border */
+	UPROPERTY(Config)
+	float HysteresisDistance{ 250.f };
+
+	/** Tiers added for enemies that weren't rendered recently, the closest tier is never biased */
+	UPROPERTY(Config)
+	int32 OffscreenTierBias{ 1 };
+
+	/** Enemies re-evaluated per frame */
+	UPROPERTY(Config)
+	int32 MaxUpdatesPerFrame{ 16 };
+};
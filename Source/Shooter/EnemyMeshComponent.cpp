@@ -0,0 +1,34 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "EnemyMeshComponent.h"
+
+UEnemyMeshComponent::UEnemyMeshComponent()
+{
+	// The update rate is driven by the UEnemyAnimBudgetSubsystem through the external tick rate control
+	bEnableUpdateRateOptimizations = true;
+}
+
+void UEnemyMeshComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	const double StartTime{ FPlatformTime::Seconds() };
+	bTicking = true;
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	bTicking = false;
+	LastGameThreadTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void UEnemyMeshComponent::PostAnimEvaluation(FAnimationEvaluationContext& EvaluationContext)
+{
+	if(bTicking)
+	{
+		Super::PostAnimEvaluation(EvaluationContext);
+		return;
+	}
+
+	// Parallel evaluation finishes after the tick returned, add the completion to the tick that dispatched it
+	const double StartTime{ FPlatformTime::Seconds() };
+	Super::PostAnimEvaluation(EvaluationContext);
+	LastGameThreadTimeMs += static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
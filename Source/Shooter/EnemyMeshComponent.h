@@ -0,0 +1,33 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "EnemyMeshComponent.generated.h"
+
+/**
+ * Skeletal mesh component that times its own updates on the game thread, so the UEnemyAnimBudgetSubsystem can tell
+ * how much of the game thread budget each enemy costs. Evaluation running in parallel on a worker thread isn't
+ * included, only the tick that dispatches it and the completion that hands the pose back.
+ */
+UCLASS()
+class SHOOTER_API UEnemyMeshComponent : public USkeletalMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	UEnemyMeshComponent();
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+	virtual void PostAnimEvaluation(FAnimationEvaluationContext& EvaluationContext) override;
+
+	/** Game thread time of the last update in milliseconds, tick and evaluation completion together */
+	FORCEINLINE float GetLastGameThreadTimeMs() const { return LastGameThreadTimeMs; }
+
+private:
+	float LastGameThreadTimeMs{ 0.f };
+
+	/** Evaluation completed during the tick is already part of the tick's time */
+	bool bTicking{ false };
+};
@@ -0,0 +1,167 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "EnemyPerceptionSubsystem.h"
+
+#include "Shooter.h"
+#include "Enemy.h"
+#include "ShooterCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Perception Update"), STAT_EnemyPerceptionUpdate, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Perception Changes"), STAT_EnemyPerceptionChanges, STATGROUP_Shooter);
+
+void UEnemyPerceptionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UEnemyPerceptionSubsystem::OnWorldPreActorTick);
+}
+
+void UEnemyPerceptionSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	Entries.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEnemyPerceptionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyPerceptionSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if(Enemy == nullptr) return;
+	for(const FEnemyPerceptionEntry& Entry : Entries)
+	{
+		if(Entry.Enemy == Enemy) return;
+	}
+
+	FEnemyPerceptionEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Enemy = Enemy;
+}
+
+void UEnemyPerceptionSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	for(int32 i = 0; i < Entries.Num(); i++)
+	{
+		if(Entries[i].Enemy == Enemy)
+		{
+			Entries.RemoveAtSwap(i);
+			return;
+		}
+	}
+}
+
+void UEnemyPerceptionSubsystem::OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	// The delegate is shared by every world, only handle our own
+	if(World != GetWorld() || Entries.Num() == 0) return;
+
+	TimeSinceUpdate += DeltaSeconds;
+	if(TimeSinceUpdate < UpdateInterval) return;
+	TimeSinceUpdate = 0.f;
+
+	UpdatePerception();
+}
+
+void UEnemyPerceptionSubsystem::UpdatePerception()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyPerceptionUpdate);
+
+	const float QueryRadius{ BuildSpatialHash() };
+
+	for(FConstPlayerControllerIterator Iterator = GetWorld() -> GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator -> Get();
+		AShooterCharacter* Target = PlayerController ? Cast<AShooterCharacter>(PlayerController -> GetPawn()) : nullptr;
+		if(Target)
+		{
+			SenseTarget(Target, QueryRadius);
+		}
+	}
+
+	for(FEnemyPerceptionEntry& Entry : Entries)
+	{
+		ApplyTransitions(Entry);
+	}
+}
+
+float UEnemyPerceptionSubsystem::BuildSpatialHash()
+{
+	Cells.Reset();
+	// Destroyed without unregistering
+	Entries.RemoveAllSwap([](const FEnemyPerceptionEntry& Entry) { return !IsValid(Entry.Enemy); });
+
+	float MaxRadius{ 0.f };
+	for(int32 i = 0; i < Entries.Num(); i++)
+	{
+		FEnemyPerceptionEntry& Entry = Entries[i];
+		Entry.SensedTarget = nullptr;
+		Entry.bSensedAttackRange = false;
+		if(Entry.Enemy -> IsDying()) continue; // Dead enemies sense nothing
+
+		Entry.AgroRadius = Entry.Enemy -> GetAgroRadius();
+		Entry.AttackRangeRadius = Entry.Enemy -> GetAttackRangeRadius();
+		Cells.Add(GetCell(Entry.Enemy -> GetActorLocation()), i);
+		MaxRadius = FMath::Max3(MaxRadius, Entry.AgroRadius, Entry.AttackRangeRadius);
+	}
+	return MaxRadius;
+}
+
+void UEnemyPerceptionSubsystem::SenseTarget(AShooterCharacter* Target, float QueryRadius)
+{
+	const FVector TargetLocation{ Target -> GetActorLocation() };
+	// Ranges are measured to the edge of the capsule, as the spheres overlapped it
+	const float TargetRadius{ Target -> GetCapsuleComponent() -> GetScaledCapsuleRadius() };
+
+	const FIntPoint MinCell{ GetCell(TargetLocation - FVector(QueryRadius + TargetRadius)) };
+	const FIntPoint MaxCell{ GetCell(TargetLocation + FVector(QueryRadius + TargetRadius)) };
+	for(int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+	{
+		for(int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+		{
+			for(auto It = Cells.CreateConstKeyIterator(FIntPoint(CellX, CellY)); It; ++It)
+			{
+				FEnemyPerceptionEntry& Entry = Entries[It.Value()];
+				const float DistanceSquared{ static_cast<float>(FVector::DistSquared(Entry.Enemy -> GetActorLocation(), TargetLocation)) };
+
+				if(DistanceSquared <= FMath::Square(Entry.AttackRangeRadius + TargetRadius))
+				{
+					Entry.bSensedAttackRange = true;
+				}
+				// Closest player wins when several are in agro range
+				if(DistanceSquared <= FMath::Square(Entry.AgroRadius + TargetRadius)
+					&& (Entry.SensedTarget == nullptr || DistanceSquared < Entry.SensedDistanceSquared))
+				{
+					Entry.SensedTarget = Target;
+					Entry.SensedDistanceSquared = DistanceSquared;
+				}
+			}
+		}
+	}
+}
+
+void UEnemyPerceptionSubsystem::ApplyTransitions(FEnemyPerceptionEntry& Entry)
+{
+	if(Entry.SensedTarget != Entry.AgroTarget)
+	{
+		Entry.AgroTarget = Entry.SensedTarget;
+		if(Entry.AgroTarget) // Leaving agro range doesn't make the enemy forget its target
+		{
+			Entry.Enemy -> OnTargetSensed(Entry.AgroTarget);
+			INC_DWORD_STAT(STAT_EnemyPerceptionChanges);
+		}
+	}
+
+	if(Entry.bSensedAttackRange != Entry.bInAttackRange)
+	{
+		Entry.bInAttackRange = Entry.bSensedAttackRange;
+		Entry.Enemy -> SetInAttackRange(Entry.bInAttackRange);
+		INC_DWORD_STAT(STAT_EnemyPerceptionChanges);
+	}
+}
@@ -0,0 +1,95 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPerceptionSubsystem.generated.h"
+
+class AEnemy;
+class AShooterCharacter;
+
+/** Perception state of a registered enemy */
+USTRUCT()
+struct FEnemyPerceptionEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AEnemy* Enemy{ nullptr };
+
+	/** Closest player in agro range on the last pass */
+	UPROPERTY()
+	AShooterCharacter* AgroTarget{ nullptr };
+
+	bool bInAttackRange{ false };
+
+	/** Read from the enemy every pass, so blueprint changes apply */
+	float AgroRadius{ 0.f };
+	float AttackRangeRadius{ 0.f };
+
+	/** Scratch state of the current pass */
+	AShooterCharacter* SensedTarget{ nullptr };
+	float SensedDistanceSquared{ 0.f };
+	bool bSensedAttackRange{ false };
+};
+
+/**
+ * Senses players for every enemy in one batched pass at a fixed rate, instead of an agro and an attack range sphere
+ * per enemy generating overlaps as they move. Enemies are put in a grid spatial hash, each player only tests the cells
+ * around it, and enemies are only told about a player entering or leaving their ranges.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UEnemyPerceptionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void RegisterEnemy(AEnemy* Enemy);
+
+	void UnregisterEnemy(AEnemy* Enemy);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Hash the enemies, test them against every player and push the transitions */
+	void UpdatePerception();
+
+	/** Put every entry in its cell, returns the largest range of the entries */
+	float BuildSpatialHash();
+
+	/** Record the player as sensed by the enemies of the cells in range */
+	void SenseTarget(AShooterCharacter* Target, float QueryRadius);
+
+	/** Tell the enemy about the ranges it entered or left since the last pass */
+	void ApplyTransitions(FEnemyPerceptionEntry& Entry);
+
+	FORCEINLINE FIntPoint GetCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+	}
+
+	FDelegateHandle PreActorTickHandle;
+
+	UPROPERTY()
+	TArray<FEnemyPerceptionEntry> Entries;
+
+	/** Cell -> indices of the entries in it, rebuilt every pass */
+	TMultiMap<FIntPoint, int32> Cells;
+
+	float TimeSinceUpdate{ 0.f };
+
+	/** Time between two perception passes */
+	UPROPERTY(Config)
+	float UpdateInterval{ 0.1f };
+
+	/** Size of the spatial hash cells, around the agro radius keeps the cells tested per player low */
+	UPROPERTY(Config)
+	float CellSize{ 1000.f };
+};
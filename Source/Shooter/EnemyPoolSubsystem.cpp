@@ -0,0 +1,115 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "EnemyPoolSubsystem.h"
+
+#include "Enemy.h"
+#include "Shooter.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Enemies"), STAT_PooledEnemies, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Pool Hits"), STAT_EnemyPoolHits, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Pool Spawns"), STAT_EnemyPoolSpawns, STATGROUP_Shooter);
+
+void UEnemyPoolSubsystem::Deinitialize()
+{
+	for(const auto& Pair : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_PooledEnemies, Pair.Value.FreeEnemies.Num());
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEnemyPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AEnemy* UEnemyPoolSubsystem::SpawnEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& Transform)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	// The enemy spawns its AI controller itself, see AutoPossessAI
+	AEnemy* Enemy = GetWorld() -> SpawnActor<AEnemy>(EnemyClass, Transform, SpawnParameters);
+	if(Enemy)
+	{
+		INC_DWORD_STAT(STAT_EnemyPoolSpawns);
+		Pools.FindOrAdd(EnemyClass.Get()).NumEnemies++;
+	}
+	return Enemy;
+}
+
+AEnemy* UEnemyPoolSubsystem::AcquireEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& Transform)
+{
+	if(EnemyClass == nullptr) return nullptr;
+
+	AEnemy* Enemy{ nullptr };
+	if(FEnemyPool* Pool = Pools.Find(EnemyClass.Get()))
+	{
+		while(Enemy == nullptr && Pool -> FreeEnemies.Num() > 0)
+		{
+			AEnemy* FreeEnemy = Pool -> FreeEnemies.Pop();
+			DEC_DWORD_STAT(STAT_PooledEnemies);
+			if(IsValid(FreeEnemy)) Enemy = FreeEnemy; // Skip enemies destroyed while pooled
+			else Pool -> NumEnemies = FMath::Max(Pool -> NumEnemies - 1, 0);
+		}
+	}
+
+	if(Enemy == nullptr)
+	{
+		return SpawnEnemy(EnemyClass, Transform);
+	}
+
+	INC_DWORD_STAT(STAT_EnemyPoolHits);
+	Enemy -> SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	Enemy -> SetActorHiddenInGame(false);
+	Enemy -> SetActorEnableCollision(true);
+	Enemy -> OnAcquiredFromPool();
+	return Enemy;
+}
+
+void UEnemyPoolSubsystem::ReleaseEnemy(AEnemy* Enemy)
+{
+	if(!IsValid(Enemy)) return;
+
+	Enemy -> OnReleasedToPool();
+	Enemy -> SetActorHiddenInGame(true);
+	Enemy -> SetActorEnableCollision(false);
+
+	Pools.FindOrAdd(Enemy -> GetClass()).FreeEnemies.Add(Enemy);
+	INC_DWORD_STAT(STAT_PooledEnemies);
+}
+
+int32 UEnemyPoolSubsystem::Prewarm(TSubclassOf<AEnemy> EnemyClass, int32 Count, int32 MaxSpawns,
+	const FTransform& Transform)
+{
+	if(EnemyClass == nullptr) return 0;
+
+	// Enemies already taken out of the pool count too, they come back to it when they die
+	const int32 NumEnemies{ Pools.FindOrAdd(EnemyClass.Get()).NumEnemies };
+	const int32 NumSpawns{ FMath::Clamp(Count - NumEnemies, 0, MaxSpawns) };
+	int32 NumAdded{ 0 };
+	for(; NumAdded < NumSpawns; NumAdded++)
+	{
+		AEnemy* Enemy = SpawnEnemy(EnemyClass, Transform);
+		if(Enemy == nullptr) break; // Retrying would fail the same way
+		ReleaseEnemy(Enemy);
+	}
+	return NumAdded;
+}
+
+void UEnemyPoolSubsystem::ReleasePooledEnemy(AEnemy* Enemy)
+{
+	if(!IsValid(Enemy)) return;
+
+	UEnemyPoolSubsystem* EnemyPool = Enemy -> GetWorld() -> GetSubsystem<UEnemyPoolSubsystem>();
+	if(EnemyPool)
+	{
+		EnemyPool -> ReleaseEnemy(Enemy);
+	}
+	else
+	{
+		Enemy -> Destroy();
+	}
+}
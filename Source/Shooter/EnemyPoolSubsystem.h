@@ -0,0 +1,61 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPoolSubsystem.generated.h"
+
+class AEnemy;
+
+/** Inactive enemies of a single class, each still possessed by its controller */
+USTRUCT()
+struct FEnemyPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AEnemy*> FreeEnemies;
+
+	/** Enemies of the class spawned by the pool, free or in use */
+	int32 NumEnemies{ 0 };
+};
+
+/**
+ * Keeps dead enemies and their AI controllers around instead of destroying them, and resets them for the next spawn,
+ * so waves don't pay for actor, controller, blackboard and behavior tree construction or for garbage collection.
+ */
+UCLASS()
+class SHOOTER_API UEnemyPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Take an enemy of the class out of the pool, spawns one with its controller if the pool is empty
+	 *  @return The enemy at full health at the given transform, running its behavior tree
+	 */
+	AEnemy* AcquireEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& Transform);
+
+	/** Hide the enemy, stop its AI and keep it for the next AcquireEnemy of its class */
+	void ReleaseEnemy(AEnemy* Enemy);
+
+	/** Spawn enemies into the pool until the pool has spawned Count of the class, counting the ones in use
+	 *  @param MaxSpawns Most enemies to spawn in this call, so prewarming can be spread over frames
+	 *  @return Number of enemies added to the pool, less than MaxSpawns once the pool is full or a spawn failed
+	 */
+	int32 Prewarm(TSubclassOf<AEnemy> EnemyClass, int32 Count, int32 MaxSpawns, const FTransform& Transform);
+
+	/** Release the enemy to the world's pool, destroys it if the world has none */
+	static void ReleasePooledEnemy(AEnemy* Enemy);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	AEnemy* SpawnEnemy(TSubclassOf<AEnemy> EnemyClass, const FTransform& Transform);
+
+	UPROPERTY()
+	TMap<UClass*, FEnemyPool> Pools;
+};
@@ -0,0 +1,179 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "EnemyWaveSpawner.h"
+
+#include "Enemy.h"
+#include "EnemyPoolSubsystem.h"
+#include "NavigationSystem.h"
+#include "Components/CapsuleComponent.h"
+
+AEnemyWaveSpawner::AEnemyWaveSpawner():
+	bStartOnBeginPlay(true),
+	bLoopWaves(false),
+	TimeBetweenWaves(5.f),
+	SpawnRadius(2000.f),
+	MaxSpawnsPerFrame(2),
+	MaxAliveEnemies(100),
+	PrewarmIndex(0),
+	bRunning(false),
+	CurrentWave(INDEX_NONE),
+	PendingSpawns(0),
+	NextWaveTime(-1.f)
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	SetRootComponent(CreateDefaultSubobject<USceneComponent>(TEXT("Root")));
+}
+
+void AEnemyWaveSpawner::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Keep as many enemies of each class as its largest wave can have alive
+	for(const FEnemyWave& Wave : Waves)
+	{
+		if(Wave.EnemyClass == nullptr) continue;
+
+		const int32 Count{ FMath::Min(Wave.Count, MaxAliveEnemies) };
+		auto* Existing = PrewarmCounts.FindByPredicate([&Wave](const TPair<TSubclassOf<AEnemy>, int32>& Pair)
+		{
+			return Pair.Key == Wave.EnemyClass;
+		});
+		if(Existing) Existing -> Value = FMath::Max(Existing -> Value, Count);
+		else PrewarmCounts.Emplace(Wave.EnemyClass, Count);
+	}
+
+	if(bStartOnBeginPlay)
+	{
+		StartWaves();
+	}
+}
+
+void AEnemyWaveSpawner::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	int32 Budget{ MaxSpawnsPerFrame };
+	Budget -= PrewarmPools(Budget);
+	if(!bRunning) return;
+
+	RemoveDeadEnemies();
+	if(PendingSpawns > 0)
+	{
+		SpawnPendingEnemies(Budget);
+	}
+	else if(AliveEnemies.Num() == 0) // Wave cleared
+	{
+		const float Now{ GetWorld() -> GetTimeSeconds() };
+		if(NextWaveTime < 0.f)
+		{
+			NextWaveTime = Now + TimeBetweenWaves;
+		}
+		else if(Now >= NextWaveTime)
+		{
+			StartNextWave();
+		}
+	}
+}
+
+void AEnemyWaveSpawner::StartWaves()
+{
+	bRunning = true;
+	CurrentWave = INDEX_NONE;
+	StartNextWave();
+}
+
+void AEnemyWaveSpawner::StopWaves()
+{
+	bRunning = false;
+	PendingSpawns = 0;
+}
+
+void AEnemyWaveSpawner::StartNextWave()
+{
+	NextWaveTime = -1.f;
+	CurrentWave++;
+	if(!Waves.IsValidIndex(CurrentWave))
+	{
+		if(!bLoopWaves || Waves.Num() == 0)
+		{
+			StopWaves();
+			return;
+		}
+		CurrentWave = 0;
+	}
+	PendingSpawns = Waves[CurrentWave].Count;
+}
+
+int32 AEnemyWaveSpawner::PrewarmPools(int32 Budget)
+{
+	if(PrewarmIndex >= PrewarmCounts.Num()) return 0;
+
+	UEnemyPoolSubsystem* EnemyPool = GetWorld() -> GetSubsystem<UEnemyPoolSubsystem>();
+	if(EnemyPool == nullptr)
+	{
+		PrewarmIndex = PrewarmCounts.Num();
+		return 0;
+	}
+
+	int32 NumSpawned{ 0 };
+	while(PrewarmIndex < PrewarmCounts.Num() && NumSpawned < Budget)
+	{
+		const TPair<TSubclassOf<AEnemy>, int32>& PrewarmCount = PrewarmCounts[PrewarmIndex];
+		const int32 MaxSpawns{ Budget - NumSpawned };
+		const int32 Spawned{ EnemyPool -> Prewarm(PrewarmCount.Key, PrewarmCount.Value, MaxSpawns, GetActorTransform()) };
+		NumSpawned += Spawned;
+		// Pool is full or the class failed to spawn, give up on it. Otherwise the budget ran out first
+		if(Spawned < MaxSpawns) PrewarmIndex++;
+	}
+	return NumSpawned;
+}
+
+void AEnemyWaveSpawner::SpawnPendingEnemies(int32 Budget)
+{
+	const FEnemyWave& Wave = Waves[CurrentWave];
+	UEnemyPoolSubsystem* EnemyPool = GetWorld() -> GetSubsystem<UEnemyPoolSubsystem>();
+
+	const int32 NumSpawns{ FMath::Min3(Budget, PendingSpawns, MaxAliveEnemies - AliveEnemies.Num()) };
+	for(int32 i = 0; i < NumSpawns; i++)
+	{
+		FTransform SpawnTransform;
+		if(!FindSpawnTransform(Wave.EnemyClass, SpawnTransform)) return; // Try again next frame
+
+		AEnemy* Enemy = EnemyPool ? EnemyPool -> AcquireEnemy(Wave.EnemyClass, SpawnTransform)
+			: GetWorld() -> SpawnActor<AEnemy>(Wave.EnemyClass, SpawnTransform);
+		PendingSpawns--;
+		if(Enemy) AliveEnemies.Add(Enemy);
+	}
+}
+
+void AEnemyWaveSpawner::RemoveDeadEnemies()
+{
+	for(int32 i = AliveEnemies.Num() - 1; i >= 0; i--)
+	{
+		if(!IsValid(AliveEnemies[i]) || AliveEnemies[i] -> IsDying())
+		{
+			AliveEnemies.RemoveAtSwap(i);
+		}
+	}
+}
+
+bool AEnemyWaveSpawner::FindSpawnTransform(TSubclassOf<AEnemy> EnemyClass, FTransform& OutTransform) const
+{
+	if(EnemyClass == nullptr) return false;
+
+	const UNavigationSystemV1* NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	FNavLocation NavLocation;
+	if(NavigationSystem == nullptr
+		|| !NavigationSystem -> GetRandomReachablePointInRadius(GetActorLocation(), SpawnRadius, NavLocation))
+	{
+		return false;
+	}
+
+	// The navmesh point is on the floor, the capsule is centered
+	const float HalfHeight{ EnemyClass -> GetDefaultObject<AEnemy>() -> GetCapsuleComponent() -> GetScaledCapsuleHalfHeight() };
+	OutTransform.SetLocation(NavLocation.Location + FVector(0.f, 0.f, HalfHeight));
+	OutTransform.SetRotation(FRotator(0.f, FMath::FRandRange(0.f, 360.f), 0.f).Quaternion());
+	return true;
+}
@@ -0,0 +1,109 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "EnemyWaveSpawner.generated.h"
+
+class AEnemy;
+
+/** A group of enemies of one class, spawned once the previous wave is cleared */
+USTRUCT(BlueprintType)
+struct FEnemyWave
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TSubclassOf<AEnemy> EnemyClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+	int32 Count{ 10 };
+};
+
+/**
+ * Spawns waves of pooled enemies on the navmesh around itself.
+ * Pools are prewarmed and enemies spawned a few per frame, so a wave of hundreds doesn't hitch.
+ */
+UCLASS()
+class SHOOTER_API AEnemyWaveSpawner : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AEnemyWaveSpawner();
+
+	virtual void Tick(float DeltaTime) override;
+
+	/** Start from the first wave */
+	UFUNCTION(BlueprintCallable, Category = "Waves")
+	void StartWaves();
+
+	UFUNCTION(BlueprintCallable, Category = "Waves")
+	void StopWaves();
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	/** Spawn enemies into the pools ahead of the waves
+	 *  @return Number of enemies spawned
+	 */
+	int32 PrewarmPools(int32 Budget);
+
+	/** Acquire enemies of the current wave from the pool, at most Budget of them */
+	void SpawnPendingEnemies(int32 Budget);
+
+	void StartNextWave();
+
+	/** Forget the enemies that died or were returned to the pool */
+	void RemoveDeadEnemies();
+
+	/** Random reachable point on the navmesh within SpawnRadius */
+	bool FindSpawnTransform(TSubclassOf<AEnemy> EnemyClass, FTransform& OutTransform) const;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta = (AllowPrivateAccess = "true"))
+	TArray<FEnemyWave> Waves;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta = (AllowPrivateAccess = "true"))
+	bool bStartOnBeginPlay;
+
+	/** Start over from the first wave once the last one is cleared */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta = (AllowPrivateAccess = "true"))
+	bool bLoopWaves;
+
+	/** Time between a wave being cleared and the next one starting */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta = (AllowPrivateAccess = "true"))
+	float TimeBetweenWaves;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta = (AllowPrivateAccess = "true", MakeEditWidget = "true"))
+	float SpawnRadius;
+
+	/** Most enemies spawned or taken from the pool per frame */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta = (AllowPrivateAccess = "true", ClampMin = "1"))
+	int32 MaxSpawnsPerFrame;
+
+	/** Most enemies of this spawner alive at once, the rest of a wave waits for them to die */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Waves", meta = (AllowPrivateAccess = "true", ClampMin = "1"))
+	int32 MaxAliveEnemies;
+
+	/** Enemies spawned by this spawner that are still alive */
+	UPROPERTY(VisibleAnywhere, Category = "Waves")
+	TArray<AEnemy*> AliveEnemies;
+
+	/** Number of enemies to keep in the pool per class, filled a few per frame */
+	TArray<TPair<TSubclassOf<AEnemy>, int32>> PrewarmCounts;
+
+	/** First entry of PrewarmCounts not fully prewarmed yet */
+	int32 PrewarmIndex;
+
+	bool bRunning;
+
+	int32 CurrentWave;
+
+	/** Enemies of the current wave not spawned yet */
+	int32 PendingSpawns;
+
+	/** World time the next wave starts at, negative while the current wave is still alive */
+	float NextWaveTime;
+};
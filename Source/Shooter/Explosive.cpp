@@ -2,6 +2,7 @@
 
 #include "Explosive.h"
 
+#include "ParticlePoolSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Sound/SoundCue.h"
@@ -34,7 +35,7 @@ void AExplosive::BulletHit_Implementation(FHitResult HitResult)
 	}
 	if(ExplodeParticles)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ExplodeParticles, HitResult.Location, FRotator(0.f), true);
+		UParticlePoolSubsystem::SpawnPooledEmitter(this, ExplodeParticles, FTransform(HitResult.Location));
 	}
 
 	// TODO: Apply explosive damage 
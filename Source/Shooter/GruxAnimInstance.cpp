@@ -6,13 +6,27 @@
 
 void UGruxAnimInstance::UpdateAnimation(float DeltaTime)
 {
+	// Nothing left to do here, see NativeUpdateAnimation and NativeThreadSafeUpdateAnimation
+}
+
+void UGruxAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeUpdateAnimation(DeltaSeconds);
+
 	if(!Enemy)
 		Enemy = Cast<AEnemy>(TryGetPawnOwner());
-	
+
 	if(Enemy)
 	{
-		FVector Velocity = Enemy -> GetVelocity();
-		Velocity.Z = 0.f;
-		Speed = Velocity.Size();
+		EnemyVelocity = Enemy -> GetVelocity();
 	}
 }
+
+void UGruxAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+	FVector Velocity = EnemyVelocity;
+	Velocity.Z = 0.f;
+	Speed = Velocity.Size();
+}
@@ -18,8 +18,16 @@ private:
 	UPROPERTY()
 	class AEnemy* Enemy;
 
+	/** Velocity of the enemy copied on the game thread, read by the worker thread */
+	FVector EnemyVelocity{ FVector::ZeroVector };
+
 public:
-	UFUNCTION(BlueprintCallable)
+	/** Kept so existing event graphs still compile, the update runs natively on a worker thread now */
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Updated natively in NativeThreadSafeUpdateAnimation, remove the call"))
 	void UpdateAnimation(float DeltaTime);
+
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 	
 };
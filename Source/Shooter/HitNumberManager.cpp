@@ -0,0 +1,285 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "HitNumberManager.h"
+
+#include "Enemy.h"
+#include "Shooter.h"
+#include "HitNumberWidget.h"
+#include "ShooterPlayerController.h"
+#include "SceneView.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hit Number Projection"), STAT_HitNumberProjection, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Merged Hit Numbers"), STAT_MergedHitNumbers, STATGROUP_Shooter);
+
+UHitNumberManager::UHitNumberManager():
+	MaxHitNumbers(32),
+	HitNumberLifetime(1.5f),
+	MergeWindow(0.2f),
+	FirstEntry(0),
+	NumActiveEntries(0)
+{
+	// Only ticks while numbers are on screen, after the camera moved this frame
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UHitNumberManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	if(PlayerController == nullptr || !PlayerController -> IsLocalController()) return;
+	if(HitNumberWidgetClass == nullptr)
+	{
+		UE_LOG(LogShooter, Error, TEXT("%s has no HitNumberWidgetClass, hit numbers fall back to the enemy ShowHitNumber event. "
+			"Reparent the HitNumber widget blueprint to UHitNumberWidget and set it here"), *GetPathName());
+		return;
+	}
+
+	// Create the whole pool up front, numbers only toggle visibility from then on
+	Entries.SetNum(MaxHitNumbers);
+	for(FHitNumberEntry& Entry : Entries)
+	{
+		Entry.Widget = CreateWidget<UHitNumberWidget>(PlayerController, HitNumberWidgetClass);
+		if(Entry.Widget)
+		{
+			Entry.Widget -> AddToViewport();
+			Entry.Widget -> SetVisibility(ESlateVisibility::Collapsed);
+		}
+	}
+}
+
+void UHitNumberManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for(FHitNumberEntry& Entry : Entries)
+	{
+		if(Entry.Widget) Entry.Widget -> RemoveFromParent();
+	}
+	for(const FStoredHitNumber& StoredHitNumber : StoredHitNumbers)
+	{
+		if(StoredHitNumber.Widget) StoredHitNumber.Widget -> RemoveFromParent();
+	}
+	Entries.Empty();
+	StoredHitNumbers.Empty();
+	PendingHitNumbers.Empty();
+	NumActiveEntries = 0;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UHitNumberManager::ShowHitNumber(AActor* HitActor, int32 Damage, const FVector& HitLocation, bool bHeadShot)
+{
+	if(Entries.Num() == 0) return;
+	const float Now{ GetWorld() -> GetTimeSeconds() };
+
+	// Only the newest numbers can still be in the merge window, walk back until they are too old
+	for(int32 Position = NumActiveEntries - 1; Position >= 0; Position--)
+	{
+		FHitNumberEntry& Entry = GetEntry(Position);
+		if(Now - Entry.StartTime > MergeWindow) break;
+		if(Entry.HitActor.Get() == HitActor)
+		{
+			Entry.Damage += Damage;
+			Entry.bHeadShot |= bHeadShot;
+			if(Entry.Widget) Entry.Widget -> ShowHitNumber(Entry.Damage, Entry.bHeadShot);
+			INC_DWORD_STAT(STAT_MergedHitNumbers);
+			return;
+		}
+	}
+
+	if(NumActiveEntries == Entries.Num()) // Every widget is taken, reuse the oldest
+	{
+		RemoveOldestEntry();
+	}
+
+	FHitNumberEntry& Entry = GetEntry(NumActiveEntries);
+	NumActiveEntries++;
+	Entry.HitActor = HitActor;
+	Entry.WorldLocation = HitLocation;
+	Entry.StartTime = Now;
+	Entry.Damage = Damage;
+	Entry.bHeadShot = bHeadShot;
+	if(Entry.Widget)
+	{
+		Entry.Widget -> ShowHitNumber(Damage, bHeadShot);
+	}
+	SetComponentTickEnabled(true);
+}
+
+void UHitNumberManager::ShowWorldHitNumber(const UObject* WorldContextObject, AActor* HitActor, int32 Damage,
+	const FVector& HitLocation, bool bHeadShot)
+{
+	const UWorld* World = GEngine -> GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	const AShooterPlayerController* PlayerController = World ? Cast<AShooterPlayerController>(World -> GetFirstPlayerController()) : nullptr;
+	UHitNumberManager* HitNumberManager = PlayerController ? PlayerController -> GetHitNumberManager() : nullptr;
+	if(HitNumberManager && HitNumberManager -> HasWidgetPool())
+	{
+		HitNumberManager -> ShowHitNumber(HitActor, Damage, HitLocation, bHeadShot);
+	}
+	else if(AEnemy* Enemy = Cast<AEnemy>(HitActor)) // Blueprints not migrated yet create their own widget
+	{
+		if(HitNumberManager)
+		{
+			HitNumberManager -> MergeEnemyHitNumber(Enemy, Damage, HitLocation, bHeadShot);
+		}
+		else
+		{
+			Enemy -> ShowHitNumber(Damage, HitLocation, bHeadShot);
+		}
+	}
+}
+
+void UHitNumberManager::MergeEnemyHitNumber(AEnemy* Enemy, int32 Damage, const FVector& HitLocation, bool bHeadShot)
+{
+	if(Enemy == nullptr) return;
+
+	// Pending numbers are all still in the merge window, the tick flushes them once it closes
+	for(FPendingHitNumber& PendingHitNumber : PendingHitNumbers)
+	{
+		if(PendingHitNumber.Enemy.Get() == Enemy)
+		{
+			PendingHitNumber.Damage += Damage;
+			PendingHitNumber.bHeadShot |= bHeadShot;
+			INC_DWORD_STAT(STAT_MergedHitNumbers);
+			return;
+		}
+	}
+
+	FPendingHitNumber& PendingHitNumber = PendingHitNumbers.AddDefaulted_GetRef();
+	PendingHitNumber.Enemy = Enemy;
+	PendingHitNumber.WorldLocation = HitLocation;
+	PendingHitNumber.StartTime = GetWorld() -> GetTimeSeconds();
+	PendingHitNumber.Damage = Damage;
+	PendingHitNumber.bHeadShot = bHeadShot;
+	SetComponentTickEnabled(true);
+}
+
+void UHitNumberManager::FlushPendingHitNumbers(float Now)
+{
+	int32 NumFlushed{ 0 };
+	while(NumFlushed < PendingHitNumbers.Num() && Now - PendingHitNumbers[NumFlushed].StartTime >= MergeWindow)
+	{
+		const FPendingHitNumber& PendingHitNumber = PendingHitNumbers[NumFlushed];
+		if(AEnemy* Enemy = PendingHitNumber.Enemy.Get())
+		{
+			Enemy -> ShowHitNumber(PendingHitNumber.Damage, PendingHitNumber.WorldLocation, PendingHitNumber.bHeadShot);
+		}
+		NumFlushed++;
+	}
+	PendingHitNumbers.RemoveAt(0, NumFlushed);
+}
+
+void UHitNumberManager::StoreHitNumber(UUserWidget* Widget, const FVector& HitLocation)
+{
+	if(Widget == nullptr) return;
+
+	FStoredHitNumber& StoredHitNumber = StoredHitNumbers.AddDefaulted_GetRef();
+	StoredHitNumber.Widget = Widget;
+	StoredHitNumber.WorldLocation = HitLocation;
+	StoredHitNumber.StartTime = GetWorld() -> GetTimeSeconds();
+	SetComponentTickEnabled(true);
+}
+
+void UHitNumberManager::StoreWorldHitNumber(const UObject* WorldContextObject, UUserWidget* Widget,
+	const FVector& HitLocation)
+{
+	if(Widget == nullptr) return;
+
+	const UWorld* World = GEngine -> GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	const AShooterPlayerController* PlayerController = World ? Cast<AShooterPlayerController>(World -> GetFirstPlayerController()) : nullptr;
+	if(PlayerController && PlayerController -> GetHitNumberManager())
+	{
+		PlayerController -> GetHitNumberManager() -> StoreHitNumber(Widget, HitLocation);
+	}
+	else // Nobody would ever remove it
+	{
+		Widget -> RemoveFromParent();
+	}
+}
+
+void UHitNumberManager::RemoveOldestEntry()
+{
+	FHitNumberEntry& Entry = GetEntry(0);
+	if(Entry.Widget) Entry.Widget -> SetVisibility(ESlateVisibility::Collapsed);
+	Entry.HitActor.Reset();
+
+	FirstEntry = (FirstEntry + 1) % Entries.Num();
+	NumActiveEntries--;
+}
+
+void UHitNumberManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Numbers are ordered by start time, the expired ones are all at the front
+	const float Now{ GetWorld() -> GetTimeSeconds() };
+	while(NumActiveEntries > 0 && Now - GetEntry(0).StartTime >= HitNumberLifetime)
+	{
+		RemoveOldestEntry();
+	}
+	int32 NumExpiredStored{ 0 };
+	while(NumExpiredStored < StoredHitNumbers.Num() && Now - StoredHitNumbers[NumExpiredStored].StartTime >= HitNumberLifetime)
+	{
+		if(StoredHitNumbers[NumExpiredStored].Widget) StoredHitNumbers[NumExpiredStored].Widget -> RemoveFromParent();
+		NumExpiredStored++;
+	}
+	StoredHitNumbers.RemoveAt(0, NumExpiredStored);
+	FlushPendingHitNumbers(Now);
+
+	if(NumActiveEntries == 0 && StoredHitNumbers.Num() == 0 && PendingHitNumbers.Num() == 0)
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+	UpdateScreenPositions();
+}
+
+void UHitNumberManager::UpdateScreenPositions()
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitNumberProjection);
+
+	const APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController -> GetLocalPlayer() : nullptr;
+	if(LocalPlayer == nullptr || LocalPlayer -> ViewportClient == nullptr) return;
+
+	// Same projection as UGameplayStatics::ProjectWorldToScreen, computed once for every number
+	FSceneViewProjectionData ProjectionData;
+	if(!LocalPlayer -> GetProjectionData(LocalPlayer -> ViewportClient -> Viewport, ProjectionData)) return;
+	const FMatrix ViewProjectionMatrix{ ProjectionData.ComputeViewProjectionMatrix() };
+	const FIntRect ViewRect{ ProjectionData.GetConstrainedViewRect() };
+
+	auto PlaceWidget = [&ViewRect, &ViewProjectionMatrix](UUserWidget* Widget, const FVector& WorldLocation)
+	{
+		if(Widget == nullptr) return;
+
+		FVector2D ScreenPosition;
+		const bool bOnScreen{ FSceneView::ProjectWorldToScreen(WorldLocation, ViewRect, ViewProjectionMatrix,
+			ScreenPosition) };
+		if(bOnScreen)
+		{
+			Widget -> SetPositionInViewport(ScreenPosition);
+		}
+
+		// Hidden while behind the camera
+		const ESlateVisibility Visibility{ bOnScreen ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed };
+		if(Widget -> GetVisibility() != Visibility)
+		{
+			Widget -> SetVisibility(Visibility);
+		}
+	};
+
+	for(int32 Position = 0; Position < NumActiveEntries; Position++)
+	{
+		const FHitNumberEntry& Entry = GetEntry(Position);
+		PlaceWidget(Entry.Widget, Entry.WorldLocation);
+	}
+	for(const FStoredHitNumber& StoredHitNumber : StoredHitNumbers)
+	{
+		PlaceWidget(StoredHitNumber.Widget, StoredHitNumber.WorldLocation);
+	}
+}
@@ -0,0 +1,153 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HitNumberManager.generated.h"
+
+class AEnemy;
+class UHitNumberWidget;
+class UUserWidget;
+
+/** A hit number on screen, a slot of the ring buffer */
+USTRUCT()
+struct FHitNumberEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UHitNumberWidget* Widget{ nullptr };
+
+	/** Actor that was hit, further hits on it are merged into this number */
+	TWeakObjectPtr<AActor> HitActor;
+
+	FVector WorldLocation{ FVector::ZeroVector };
+
+	/** World time the number appeared at */
+	float StartTime{ 0.f };
+
+	int32 Damage{ 0 };
+
+	bool bHeadShot{ false };
+};
+
+/** A hit number widget created by an enemy blueprint, only placed and removed by the manager */
+USTRUCT()
+struct FStoredHitNumber
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UUserWidget* Widget{ nullptr };
+
+	FVector WorldLocation{ FVector::ZeroVector };
+
+	float StartTime{ 0.f };
+};
+
+/** Hits on an enemy waiting for the merge window to close, before its blueprint creates one widget for all of them */
+USTRUCT()
+struct FPendingHitNumber
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<AEnemy> Enemy;
+
+	FVector WorldLocation{ FVector::ZeroVector };
+
+	/** World time of the first hit */
+	float StartTime{ 0.f };
+
+	int32 Damage{ 0 };
+
+	bool bHeadShot{ false };
+};
+
+/**
+ * Shows the hit numbers of every enemy from one fixed pool of widgets.
+ * Numbers live in a ring buffer ordered by start time, so expiring is popping from the front,
+ * and they are all projected to the screen with one view projection per frame.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SHOOTER_API UHitNumberManager : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHitNumberManager();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Show a hit number, or add the damage to the number shown for the same actor within the merge window */
+	void ShowHitNumber(AActor* HitActor, int32 Damage, const FVector& HitLocation, bool bHeadShot);
+
+	/** Show the hit number through the first player controller's manager.
+	 *  Falls back to the enemy's ShowHitNumber blueprint event while the manager has no widget class,
+	 *  still merging the hits of each merge window into one event
+	 */
+	static void ShowWorldHitNumber(const UObject* WorldContextObject, AActor* HitActor, int32 Damage,
+		const FVector& HitLocation, bool bHeadShot);
+
+	/** Place the widget over the location until its lifetime is up, then remove it from the viewport */
+	void StoreHitNumber(UUserWidget* Widget, const FVector& HitLocation);
+
+	/** Add the hit to the enemy's pending number, or start one. Its ShowHitNumber event fires once the merge window closes */
+	void MergeEnemyHitNumber(AEnemy* Enemy, int32 Damage, const FVector& HitLocation, bool bHeadShot);
+
+	/** Store the widget in the first player controller's manager, removes it right away if there is none */
+	static void StoreWorldHitNumber(const UObject* WorldContextObject, UUserWidget* Widget, const FVector& HitLocation);
+
+	/** True once the pooled widgets are created, false while HitNumberWidgetClass is unset */
+	FORCEINLINE bool HasWidgetPool() const { return Entries.Num() > 0; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** Entry at a position counted from the oldest number */
+	FORCEINLINE FHitNumberEntry& GetEntry(int32 Position) { return Entries[(FirstEntry + Position) % Entries.Num()]; }
+
+	/** Hide the oldest number and free its slot */
+	void RemoveOldestEntry();
+
+	/** Move every number to its projected screen position */
+	void UpdateScreenPositions();
+
+	/** Fire the ShowHitNumber event of every pending number whose merge window closed */
+	void FlushPendingHitNumbers(float Now);
+
+	UPROPERTY(EditDefaultsOnly, Category = "Hit Numbers")
+	TSubclassOf<UHitNumberWidget> HitNumberWidgetClass;
+
+	/** Most numbers on screen at once, the oldest number is reused once they are all taken */
+	UPROPERTY(EditDefaultsOnly, Category = "Hit Numbers", meta = (ClampMin = "1"))
+	int32 MaxHitNumbers;
+
+	/** Time a number stays on screen */
+	UPROPERTY(EditDefaultsOnly, Category = "Hit Numbers")
+	float HitNumberLifetime;
+
+	/** Hits on the same actor within this time after a number appeared add to it instead of showing a new one */
+	UPROPERTY(EditDefaultsOnly, Category = "Hit Numbers")
+	float MergeWindow;
+
+	/** Ring buffer of the numbers, each slot owns a pooled widget */
+	UPROPERTY()
+	TArray<FHitNumberEntry> Entries;
+
+	/** Widgets created by enemy blueprints, ordered by start time */
+	UPROPERTY()
+	TArray<FStoredHitNumber> StoredHitNumbers;
+
+	/** Hits waiting for an enemy blueprint to show them, ordered by start time */
+	UPROPERTY()
+	TArray<FPendingHitNumber> PendingHitNumbers;
+
+	/** Slot of the oldest number */
+	int32 FirstEntry;
+
+	/** Numbers currently on screen */
+	int32 NumActiveEntries;
+};
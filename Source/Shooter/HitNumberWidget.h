@@ -0,0 +1,22 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "HitNumberWidget.generated.h"
+
+/**
+ * Base class of the hit number widget blueprint. Instances are pooled by the UHitNumberManager
+ * and reused for every hit, so the blueprint should restart its animation each time a number is shown.
+ */
+UCLASS(Abstract)
+class SHOOTER_API UHitNumberWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** Called when the widget starts showing a hit, and again when more hits are merged into it */
+	UFUNCTION(BlueprintImplementableEvent)
+	void ShowHitNumber(int32 Damage, bool bHeadShot);
+};
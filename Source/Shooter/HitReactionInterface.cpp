@@ -0,0 +1,4 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "HitReactionInterface.h"
@@ -0,0 +1,27 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "HitReactionInterface.generated.h"
+
+UINTERFACE()
+class UHitReactionInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Reaction of a victim to the hits it took, such as a stun or a hit montage.
+ * Called by the UCombatDamageSubsystem once per victim and frame, however many hits got merged.
+ */
+class SHOOTER_API IHitReactionInterface
+{
+	GENERATED_BODY()
+
+public:
+	/** @param HitCount Number of hits merged into the damage the victim just took */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
+	void HitReact(int32 HitCount);
+};
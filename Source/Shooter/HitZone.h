@@ -0,0 +1,41 @@
+﻿#pragma once
+
+UENUM(BlueprintType)
+enum class EHitZone : uint8
+{
+	EHZ_Head UMETA(DisplayName = "Head"),
+	EHZ_Torso UMETA(DisplayName = "Torso"),
+	EHZ_Limbs UMETA(DisplayName = "Limbs"),
+
+	EHZ_Max UMETA(DisplayName = "DefaultMax")
+};
+
+/** Bone and physics body -> hit zone lookup with a damage multiplier per zone, built once and shared between enemies */
+struct FHitZoneTable
+{
+	/** Hit zone of each bone, indexed by the bone index of the reference skeleton */
+	TArray<EHitZone> BoneZones;
+
+	/** Hit zone of each physics body, indexed like the bodies of the physics asset (FHitResult::Item) */
+	TArray<EHitZone> BodyZones;
+
+	/** Damage multiplier of each hit zone, indexed by EHitZone */
+	float DamageMultipliers[static_cast<uint8>(EHitZone::EHZ_Max)]{ 1.f, 1.f, 1.f };
+
+	FORCEINLINE EHitZone GetZone(int32 BoneIndex) const
+	{
+		return BoneZones.IsValidIndex(BoneIndex) ? BoneZones[BoneIndex] : EHitZone::EHZ_Torso;
+	}
+
+	FORCEINLINE bool GetBodyZone(int32 BodyIndex, EHitZone& OutZone) const
+	{
+		if(!BodyZones.IsValidIndex(BodyIndex)) return false;
+		OutZone = BodyZones[BodyIndex];
+		return true;
+	}
+
+	FORCEINLINE float GetDamageMultiplier(EHitZone Zone) const
+	{
+		return Zone < EHitZone::EHZ_Max ? DamageMultipliers[static_cast<uint8>(Zone)] : 1.f;
+	}
+};
@@ -0,0 +1,118 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "HitZoneSubsystem.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
+
+void UHitZoneSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+#if WITH_EDITOR
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddUObject(this, &UHitZoneSubsystem::OnObjectsReplaced);
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UHitZoneSubsystem::OnObjectPropertyChanged);
+#endif
+}
+
+void UHitZoneSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+#endif
+	Tables.Empty();
+
+	Super::Deinitialize();
+}
+
+TSharedPtr<const FHitZoneTable> UHitZoneSubsystem::FindOrBuildTable(const UClass* EnemyClass,
+	const USkeletalMeshComponent* Mesh, const TMap<FName, EHitZone>& ZoneBones, const TMap<EHitZone, float>& DamageMultipliers)
+{
+	if(Mesh == nullptr || Mesh -> GetSkeletalMeshAsset() == nullptr) return nullptr;
+
+	const TTuple<FObjectKey, FObjectKey, FObjectKey> TableKey{ FObjectKey(EnemyClass),
+		FObjectKey(Mesh -> GetSkeletalMeshAsset()), FObjectKey(Mesh -> GetPhysicsAsset()) };
+	if(const TSharedPtr<const FHitZoneTable>* ExistingTable = Tables.Find(TableKey))
+	{
+		return *ExistingTable;
+	}
+
+	TSharedPtr<const FHitZoneTable> NewTable = BuildTable(Mesh, ZoneBones, DamageMultipliers);
+	Tables.Add(TableKey, NewTable);
+	return NewTable;
+}
+
+TSharedPtr<const FHitZoneTable> UHitZoneSubsystem::FindOrBuildWorldTable(const UObject* WorldContextObject,
+	const UClass* EnemyClass, const USkeletalMeshComponent* Mesh, const TMap<FName, EHitZone>& ZoneBones,
+	const TMap<EHitZone, float>& DamageMultipliers)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject -> GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World -> GetGameInstance() : nullptr;
+	if(UHitZoneSubsystem* HitZoneSubsystem = GameInstance ? GameInstance -> GetSubsystem<UHitZoneSubsystem>() : nullptr)
+	{
+		return HitZoneSubsystem -> FindOrBuildTable(EnemyClass, Mesh, ZoneBones, DamageMultipliers);
+	}
+	return BuildTable(Mesh, ZoneBones, DamageMultipliers);
+}
+
+TSharedPtr<const FHitZoneTable> UHitZoneSubsystem::BuildTable(const USkeletalMeshComponent* Mesh,
+	const TMap<FName, EHitZone>& ZoneBones, const TMap<EHitZone, float>& DamageMultipliers)
+{
+	const USkeletalMesh* SkeletalMesh = Mesh ? Mesh -> GetSkeletalMeshAsset() : nullptr;
+	if(SkeletalMesh == nullptr) return nullptr;
+
+	TSharedRef<FHitZoneTable> NewTable = MakeShared<FHitZoneTable>();
+	for(const auto& Pair : DamageMultipliers)
+	{
+		if(Pair.Key < EHitZone::EHZ_Max)
+			NewTable -> DamageMultipliers[static_cast<uint8>(Pair.Key)] = Pair.Value;
+	}
+
+	const FReferenceSkeleton& RefSkeleton = SkeletalMesh -> GetRefSkeleton();
+	const int32 NumBones{ RefSkeleton.GetNum() };
+	NewTable -> BoneZones.SetNum(NumBones);
+	for(int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+	{
+		// Parents always come before their children, so the parent's zone is already resolved
+		const int32 ParentIndex{ RefSkeleton.GetParentIndex(BoneIndex) };
+		const EHitZone* ListedZone = ZoneBones.Find(RefSkeleton.GetBoneName(BoneIndex));
+		if(ListedZone) NewTable -> BoneZones[BoneIndex] = *ListedZone;
+		else if(ParentIndex != INDEX_NONE) NewTable -> BoneZones[BoneIndex] = NewTable -> BoneZones[ParentIndex];
+		else NewTable -> BoneZones[BoneIndex] = EHitZone::EHZ_Torso;
+	}
+
+	// Traces against the mesh hit its physics bodies, resolve each body's bone once here
+	if(const UPhysicsAsset* PhysicsAsset = Mesh -> GetPhysicsAsset())
+	{
+		const int32 NumBodies{ PhysicsAsset -> SkeletalBodySetups.Num() };
+		NewTable -> BodyZones.SetNum(NumBodies);
+		for(int32 BodyIndex = 0; BodyIndex < NumBodies; BodyIndex++)
+		{
+			const USkeletalBodySetup* BodySetup = PhysicsAsset -> SkeletalBodySetups[BodyIndex];
+			NewTable -> BodyZones[BodyIndex] = NewTable -> GetZone(BodySetup ? RefSkeleton.FindBoneIndex(BodySetup -> BoneName) : INDEX_NONE);
+		}
+	}
+	return NewTable;
+}
+
+#if WITH_EDITOR
+void UHitZoneSubsystem::OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	// Enemies keep the tables they already hold, new ones get rebuilt
+	Tables.Empty();
+}
+
+void UHitZoneSubsystem::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	if(Object && (Object -> IsA<USkeletalMesh>() || Object -> IsA<UPhysicsAsset>() || Object -> HasAnyFlags(RF_ClassDefaultObject)))
+	{
+		Tables.Empty();
+	}
+}
+#endif
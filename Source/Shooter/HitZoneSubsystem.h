@@ -0,0 +1,55 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HitZone.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "HitZoneSubsystem.generated.h"
+
+class USkeletalMeshComponent;
+
+/**
+ * Builds the hit zone tables of the enemies and shares them between every enemy of the same class, mesh and
+ * physics asset. Lives on the game instance, so every play session starts with fresh tables, and in the editor
+ * the tables are dropped whenever a blueprint is recompiled or an asset is edited or reimported.
+ */
+UCLASS()
+class SHOOTER_API UHitZoneSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Shared table for the enemy class and its mesh, built on first use
+	 *  @param ZoneBones Hit zone of the listed bones, the other bones inherit the zone of their closest listed parent
+	 *  @param DamageMultipliers Damage multiplier of each hit zone
+	 */
+	TSharedPtr<const FHitZoneTable> FindOrBuildTable(const UClass* EnemyClass, const USkeletalMeshComponent* Mesh,
+		const TMap<FName, EHitZone>& ZoneBones, const TMap<EHitZone, float>& DamageMultipliers);
+
+	/** Table from the game instance's subsystem, an unshared one if there is none */
+	static TSharedPtr<const FHitZoneTable> FindOrBuildWorldTable(const UObject* WorldContextObject, const UClass* EnemyClass,
+		const USkeletalMeshComponent* Mesh, const TMap<FName, EHitZone>& ZoneBones, const TMap<EHitZone, float>& DamageMultipliers);
+
+private:
+	static TSharedPtr<const FHitZoneTable> BuildTable(const USkeletalMeshComponent* Mesh,
+		const TMap<FName, EHitZone>& ZoneBones, const TMap<EHitZone, float>& DamageMultipliers);
+
+#if WITH_EDITOR
+	/** Blueprints got recompiled, their hit zone bones may have changed */
+	void OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+
+	/** A mesh, physics asset or enemy default got edited or reimported */
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+
+	FDelegateHandle ObjectsReplacedHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+#endif
+
+	/** Enemy class, skeletal mesh and physics asset -> table */
+	TMap<TTuple<FObjectKey, FObjectKey, FObjectKey>, TSharedPtr<const FHitZoneTable>> Tables;
+};
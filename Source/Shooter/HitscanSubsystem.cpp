@@ -0,0 +1,82 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "HitscanSubsystem.h"
+
+#include "Shooter.h"
+#include "ShooterCharacter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Resolve Hitscan Shots"), STAT_ResolveHitscanShots, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Shots"), STAT_HitscanShots, STATGROUP_Shooter);
+
+void UHitscanSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UHitscanSubsystem::OnWorldPreActorTick);
+}
+
+void UHitscanSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	PendingShots.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UHitscanSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UHitscanSubsystem::QueueShot(FHitscanShot&& Shot)
+{
+	Shot.TraceHandle = GetWorld() -> AsyncLineTraceByChannel(EAsyncTraceType::Single, Shot.TraceStart, Shot.TraceEnd,
+		ECollisionChannel::ECC_Visibility);
+	PendingShots.Add(MoveTemp(Shot));
+}
+
+void UHitscanSubsystem::OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	// The delegate is shared by every world, only handle our own
+	if(World != GetWorld() || PendingShots.Num() == 0) return;
+
+	ResolvePendingShots();
+}
+
+void UHitscanSubsystem::ResolvePendingShots()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ResolveHitscanShots);
+	INC_DWORD_STAT_BY(STAT_HitscanShots, PendingShots.Num());
+
+	// Move the batch out first, resolving a shot may queue new ones
+	TArray<FHitscanShot> Shots = MoveTemp(PendingShots);
+	PendingShots.Reset();
+
+	UWorld* World = GetWorld();
+	for(const FHitscanShot& Shot : Shots)
+	{
+		AShooterCharacter* Shooter = Shot.Shooter.Get();
+		if(Shooter == nullptr) continue;
+
+		FHitResult BeamHitResult;
+		FTraceDatum TraceDatum;
+		if(World -> QueryTraceData(Shot.TraceHandle, TraceDatum))
+		{
+			if(TraceDatum.OutHits.Num() > 0)
+			{
+				BeamHitResult = TraceDatum.OutHits[0];
+			}
+		}
+		else // Trace data has expired (e.g. a long hitch), fall back to tracing now
+		{
+			World -> LineTraceSingleByChannel(BeamHitResult, Shot.TraceStart, Shot.TraceEnd, ECollisionChannel::ECC_Visibility);
+		}
+
+		if(!BeamHitResult.bBlockingHit) // Is there something between the barrel and the BeamEnd?
+		{
+			BeamHitResult.Location = Shot.BeamEndLocation;
+		}
+		Shooter -> ResolveBullet(Shot, BeamHitResult);
+	}
+}
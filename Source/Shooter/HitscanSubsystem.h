@@ -0,0 +1,65 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "HitscanSubsystem.generated.h"
+
+/** A shot waiting for its async barrel trace to finish */
+struct FHitscanShot
+{
+	/** Character who fired the shot */
+	TWeakObjectPtr<class AShooterCharacter> Shooter;
+
+	/** Weapon the shot was fired from, used as the damage causer */
+	TWeakObjectPtr<class AWeapon> Weapon;
+
+	/** Damage values captured when firing, so swapping weapons before resolving doesn't change them */
+	float Damage{ 0.f };
+	float HeadshotDamage{ 0.f };
+
+	/** Transform of the BarrelSocket when the shot was fired */
+	FTransform MuzzleTransform;
+
+	/** Segment traced from the gun barrel */
+	FVector TraceStart{ FVector::ZeroVector };
+	FVector TraceEnd{ FVector::ZeroVector };
+
+	/** Where the beam ends if the barrel trace doesn't hit anything */
+	FVector BeamEndLocation{ FVector::ZeroVector };
+
+	FTraceHandle TraceHandle;
+};
+
+/**
+ * Collects every shot fired during a frame and submits its barrel trace asynchronously.
+ * The results are resolved in one batch at the start of the next frame, before actors tick.
+ */
+UCLASS()
+class SHOOTER_API UHitscanSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Submit the async barrel trace for a shot, its hit is handled at the start of next frame */
+	void QueueShot(FHitscanShot&& Shot);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Fetch trace results for all shots queued last frame and hand them back to their shooters */
+	void ResolvePendingShots();
+
+	/** Shots fired and waiting for their trace results */
+	TArray<FHitscanShot> PendingShots;
+
+	FDelegateHandle PreActorTickHandle;
+};
@@ -0,0 +1,151 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "InventoryComponent.h"
+
+#include "Item.h"
+
+UInventoryComponent::UInventoryComponent():
+	Capacity(6),
+	FreeSlotMask(0),
+	NumItems(0),
+	HighlightedSlotIndex(-1)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	bWantsInitializeComponent = true;
+
+	AmmoCounts.Init(0, static_cast<int32>(EAmmoType::EAT_Max));
+}
+
+void UInventoryComponent::InitializeComponent()
+{
+	Super::InitializeComponent();
+
+	Capacity = FMath::Clamp(Capacity, 1, MaxCapacity);
+	Slots.Init(nullptr, Capacity);
+	FreeSlotMask = GetCapacityMask();
+	NumItems = 0;
+}
+
+uint64 UInventoryComponent::GetCapacityMask() const
+{
+	return Capacity >= MaxCapacity ? MAX_uint64 : (uint64{ 1 } << Capacity) - 1;
+}
+
+int32 UInventoryComponent::AddItem(AItem* Item)
+{
+	if(Item == nullptr) return INDEX_NONE;
+
+	const int32 Index{ GetFirstFreeSlot() };
+	if(Index != INDEX_NONE)
+	{
+		SetItem(Index, Item);
+	}
+	return Index;
+}
+
+void UInventoryComponent::SetItem(int32 Index, AItem* Item)
+{
+	if(!Slots.IsValidIndex(Index)) return;
+	if(Item == nullptr)
+	{
+		RemoveItem(Index);
+		return;
+	}
+
+	const uint64 SlotBit{ uint64{ 1 } << Index };
+	if(FreeSlotMask & SlotBit)
+	{
+		FreeSlotMask &= ~SlotBit;
+		NumItems++;
+	}
+	Slots[Index] = Item;
+	Item -> SetSlotIndex(Index);
+	SlotChangedDelegate.Broadcast(Index);
+}
+
+AItem* UInventoryComponent::RemoveItem(int32 Index)
+{
+	if(!Slots.IsValidIndex(Index)) return nullptr;
+
+	AItem* Item = Slots[Index];
+	const uint64 SlotBit{ uint64{ 1 } << Index };
+	if(!(FreeSlotMask & SlotBit))
+	{
+		FreeSlotMask |= SlotBit;
+		NumItems--;
+	}
+	Slots[Index] = nullptr;
+	SlotChangedDelegate.Broadcast(Index);
+	return Item;
+}
+
+AItem* UInventoryComponent::GetItem(int32 Index) const
+{
+	return Slots.IsValidIndex(Index) ? Slots[Index] : nullptr;
+}
+
+int32 UInventoryComponent::GetFirstFreeSlot() const
+{
+	if(FreeSlotMask == 0) return INDEX_NONE;
+	return static_cast<int32>(FMath::CountTrailingZeros64(FreeSlotMask));
+}
+
+int32 UInventoryComponent::GetNextOccupiedSlot(int32 Index) const
+{
+	const uint64 OccupiedMask{ ~FreeSlotMask & GetCapacityMask() };
+	if(OccupiedMask == 0) return INDEX_NONE;
+
+	// Occupied slots after the index, or all of them to wrap around
+	const uint64 AfterIndex{ Index + 1 < MaxCapacity ? OccupiedMask & (MAX_uint64 << (Index + 1)) : 0 };
+	return static_cast<int32>(FMath::CountTrailingZeros64(AfterIndex ? AfterIndex : OccupiedMask));
+}
+
+int32 UInventoryComponent::GetPreviousOccupiedSlot(int32 Index) const
+{
+	const uint64 OccupiedMask{ ~FreeSlotMask & GetCapacityMask() };
+	if(OccupiedMask == 0) return INDEX_NONE;
+
+	// Occupied slots before the index, or all of them to wrap around
+	const uint64 BeforeIndex{ Index > 0 ? OccupiedMask & ((uint64{ 1 } << FMath::Min(Index, MaxCapacity - 1)) - 1) : 0 };
+	return 63 - static_cast<int32>(FMath::CountLeadingZeros64(BeforeIndex ? BeforeIndex : OccupiedMask));
+}
+
+int32 UInventoryComponent::GetAmmo(EAmmoType AmmoType) const
+{
+	const int32 Index{ static_cast<int32>(AmmoType) };
+	return AmmoCounts.IsValidIndex(Index) ? AmmoCounts[Index] : 0;
+}
+
+void UInventoryComponent::SetAmmo(EAmmoType AmmoType, int32 Amount)
+{
+	const int32 Index{ static_cast<int32>(AmmoType) };
+	if(AmmoCounts.IsValidIndex(Index))
+	{
+		AmmoCounts[Index] = FMath::Max(Amount, 0);
+		AmmoChangedDelegate.Broadcast(AmmoType);
+	}
+}
+
+void UInventoryComponent::AddAmmo(EAmmoType AmmoType, int32 Amount)
+{
+	SetAmmo(AmmoType, GetAmmo(AmmoType) + Amount);
+}
+
+void UInventoryComponent::BroadcastEquipItem(int32 CurrentSlotIndex, int32 NewSlotIndex) const
+{
+	EquipItemDelegate.Broadcast(CurrentSlotIndex, NewSlotIndex);
+}
+
+void UInventoryComponent::HighlightFreeSlot()
+{
+	const int32 FreeSlot{ GetFirstFreeSlot() };
+	HighlightIconDelegate.Broadcast(FreeSlot, true);
+	HighlightedSlotIndex = FreeSlot;
+}
+
+void UInventoryComponent::UnHighlightSlot()
+{
+	HighlightIconDelegate.Broadcast(HighlightedSlotIndex, false);
+	HighlightedSlotIndex = -1; // Highlighted slot is empty(null) now.
+}
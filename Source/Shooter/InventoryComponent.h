@@ -0,0 +1,120 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "AmmoType.h"
+#include "InventoryComponent.generated.h"
+
+class AItem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FEquipItemDelegate, int32, CurrentSlotIndex, int32, NewSlotIndex);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHighlightIconDelegate, int32, SlotIndex, bool, bStartAnimation);
+DECLARE_MULTICAST_DELEGATE_OneParam(FInventorySlotChangedDelegate, int32 /* SlotIndex */);
+DECLARE_MULTICAST_DELEGATE_OneParam(FInventoryAmmoChangedDelegate, EAmmoType /* AmmoType */);
+
+/**
+ * Fixed capacity item slots and carried ammo.
+ * Free slots are tracked in a bitmask and ammo is indexed by EAmmoType, so no operation scans the inventory.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SHOOTER_API UInventoryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryComponent();
+
+	virtual void InitializeComponent() override;
+
+	/** Most slots an inventory can have, one bit of the free slot mask each */
+	static constexpr int32 MaxCapacity{ 64 };
+
+	/** Put the item in the first free slot
+	 *  @return The slot the item went to, INDEX_NONE if the inventory is full
+	 */
+	int32 AddItem(AItem* Item);
+
+	/** Put the item in the slot, replacing whatever was there */
+	void SetItem(int32 Index, AItem* Item);
+
+	/** Empty the slot, returns the item that was in it */
+	AItem* RemoveItem(int32 Index);
+
+	/** Item in the slot, null for free or invalid slots */
+	AItem* GetItem(int32 Index) const;
+
+	/** Lowest free slot, INDEX_NONE if the inventory is full */
+	int32 GetFirstFreeSlot() const;
+
+	/** Next occupied slot after the index, wrapping around to the first one */
+	int32 GetNextOccupiedSlot(int32 Index) const;
+
+	/** Previous occupied slot before the index, wrapping around to the last one */
+	int32 GetPreviousOccupiedSlot(int32 Index) const;
+
+	UFUNCTION(BlueprintPure, Category = Inventory)
+	int32 GetAmmo(EAmmoType AmmoType) const;
+
+	void SetAmmo(EAmmoType AmmoType, int32 Amount);
+	void AddAmmo(EAmmoType AmmoType, int32 Amount);
+
+	/** Tell the inventory bar the equipped slot changed
+	 *  @param CurrentSlotIndex Slot equipped before, -1 if nothing was equipped
+	 */
+	void BroadcastEquipItem(int32 CurrentSlotIndex, int32 NewSlotIndex) const;
+
+	/** Highlight the slot the next picked up item goes to */
+	void HighlightFreeSlot();
+	void UnHighlightSlot();
+
+private:
+	/** Mask with a bit set for each slot within Capacity */
+	uint64 GetCapacityMask() const;
+
+	/** Number of item slots */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = "true", ClampMin = "1", ClampMax = "64"))
+	int32 Capacity;
+
+	/** Items by slot index, null for free slots */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = "true"))
+	TArray<AItem*> Slots;
+
+	/** Bit set for each free slot */
+	uint64 FreeSlotMask;
+
+	int32 NumItems;
+
+	/** Carried ammo, indexed by EAmmoType */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = "true"))
+	TArray<int32> AmmoCounts;
+
+	/* Delegate for sending slot information to Inventory bar when equipping */
+	UPROPERTY(BlueprintAssignable, Category = Delegates, meta = (AllowPrivateAccess = "true"))
+	FEquipItemDelegate EquipItemDelegate;
+
+	/** Delegate for highlighting the selected slot in the Inventory */
+	UPROPERTY(BlueprintAssignable, Category = Delegates, meta = (AllowPrivateAccess = "true"))
+	FHighlightIconDelegate HighlightIconDelegate;
+
+	/** Slot index of the highlighted slot */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = "true"))
+	int32 HighlightedSlotIndex;
+
+	/** Called after the item in a slot changed */
+	FInventorySlotChangedDelegate SlotChangedDelegate;
+
+	/** Called after the carried ammo of a type changed */
+	FInventoryAmmoChangedDelegate AmmoChangedDelegate;
+
+public:
+	FORCEINLINE int32 GetCapacity() const { return Capacity; }
+	FORCEINLINE int32 GetNumItems() const { return NumItems; }
+	FORCEINLINE bool IsFull() const { return FreeSlotMask == 0; }
+	FORCEINLINE int32 GetHighlightedSlotIndex() const { return HighlightedSlotIndex; }
+	FORCEINLINE FEquipItemDelegate& GetEquipItemDelegate() { return EquipItemDelegate; }
+	FORCEINLINE FHighlightIconDelegate& GetHighlightIconDelegate() { return HighlightIconDelegate; }
+	FORCEINLINE FInventorySlotChangedDelegate& GetSlotChangedDelegate() { return SlotChangedDelegate; }
+	FORCEINLINE FInventoryAmmoChangedDelegate& GetAmmoChangedDelegate() { return AmmoChangedDelegate; }
+};
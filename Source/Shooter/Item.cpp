@@ -3,6 +3,10 @@
 
 #include "Item.h"
 
+#include "BakedCurveSubsystem.h"
+#include "ItemGlowSubsystem.h"
+#include "ItemRegistrySubsystem.h"
+#include "Shooter.h"
 #include "ShooterCharacter.h"
 #include "Components/BoxComponent.h"
 #include "Components/WidgetComponent.h"
@@ -12,6 +16,9 @@
 #include "Sound/SoundCue.h"
 #include "Curves/CurveVector.h"
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Item Ticks"), STAT_ActiveItemTicks, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Collision Changes"), STAT_ItemCollisionChanges, STATGROUP_Shooter);
+
 // Sets default values
 AItem::AItem():
 	ItemType(EItemType::EIT_Weapon),
@@ -27,6 +34,8 @@ AItem::AItem():
 	InterpInitialYawOffset(0.f),
 	InterpLocationIndex(0),
 	InterpSizeScale(1.f),
+	BakedItemZCurve(nullptr),
+	BakedItemScaleCurve(nullptr),
 	// Glow material variables
 	bCustomDepthOnBeginPlay(false),
 	GlowMaterialIndex(0),
@@ -38,12 +47,16 @@ AItem::AItem():
 	FresnelExponent(3.f),
 	FresnelReflectFraction(4.f),
 	GlowPulseDuration(5.f),
+	BakedGlowPulseCurve(nullptr),
+	BakedGlowPulseInterpCurve(nullptr),
+	bGlowPulseRegistered(false),
 	// Inventory
 	SlotIndex(0),
 	bCharacterInventoryFull(false)
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+ 	// Tick is only enabled while the item has per-frame work, see RefreshTickEnabled
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	ItemMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("ItemMesh"));
 	SetRootComponent(ItemMesh);
@@ -57,8 +70,11 @@ AItem::AItem():
 	PickupWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("PickupWidget"));
 	PickupWidget -> SetupAttachment(ItemMesh);
 
+	// AreaSphere only defines the pickup radius, the item registry finds items without overlaps
 	AreaSphere = CreateDefaultSubobject<USphereComponent>(TEXT("AreaSphere"));
 	AreaSphere -> SetupAttachment(ItemMesh);
+	AreaSphere -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	AreaSphere -> SetGenerateOverlapEvents(false);
 }
 
 // Called when the game starts or when spawned
@@ -75,44 +91,55 @@ void AItem::BeginPlay()
 	LoadRarityData();
 	// Set ActiveStars array based on item rarity
 	SetActiveStars();
-	// Setup overlap for AreaSphere
-	AreaSphere -> OnComponentBeginOverlap.AddDynamic(this, &AItem::OnSphereBeginOverlap);
-	AreaSphere -> OnComponentEndOverlap.AddDynamic(this, &AItem::OnSphereEndOverlap);
-
 	// Set properties for Item's components based on the state
 	UpdateItemProperties(ItemState);
+	UpdatePickupRegistration();
 
 	// Initialize outline post-process
 	InitializeCustomDepth();
 
 	// Start glowing
+	BakedGlowPulseCurve = UBakedCurveSubsystem::FindOrBakeCurve(this, GlowPulseCurve);
+	BakedGlowPulseInterpCurve = UBakedCurveSubsystem::FindOrBakeCurve(this, GlowPulseInterpCurve);
 	StartGlowPulseTimer();
+	RefreshTickEnabled();
 }
 
-void AItem::OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if(OtherActor)
+	if(IsActorTickEnabled())
+	{
+		DEC_DWORD_STAT(STAT_ActiveItemTicks);
+	}
+	if(UItemRegistrySubsystem* ItemRegistry = GetWorld() -> GetSubsystem<UItemRegistrySubsystem>())
+	{
+		ItemRegistry -> UnregisterItem(this);
+	}
+	if(bGlowPulseRegistered)
 	{
-		AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(OtherActor);
-		if(ShooterCharacter)
+		if(UItemGlowSubsystem* ItemGlow = GetWorld() -> GetSubsystem<UItemGlowSubsystem>())
 		{
-			ShooterCharacter -> IncrementOverlappedItemCount(1);
+			ItemGlow -> UnregisterItem(this);
 		}
+		bGlowPulseRegistered = false;
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
-void AItem::OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex)
+void AItem::UpdatePickupRegistration()
 {
-	if(OtherActor)
+	UItemRegistrySubsystem* ItemRegistry = GetWorld() -> GetSubsystem<UItemRegistrySubsystem>();
+	if(ItemRegistry == nullptr) return;
+
+	// Registering again moves the entry to where the item came to rest
+	if(ItemState == EItemState::EIS_Pickup)
 	{
-		AShooterCharacter* ShooterCharacter = Cast<AShooterCharacter>(OtherActor);
-		if(ShooterCharacter)
-		{
-			ShooterCharacter -> IncrementOverlappedItemCount(-1);
-			ShooterCharacter -> UnHighlightInventorySlot();
-		}
+		ItemRegistry -> RegisterItem(this, AreaSphere -> GetScaledSphereRadius());
+	}
+	else
+	{
+		ItemRegistry -> UnregisterItem(this);
 	}
 }
 
@@ -135,71 +162,92 @@ void AItem::SetActiveStars()
 	}
 }
 
+const FItemCollisionProfile& AItem::GetMeshCollisionProfile(EItemState State)
+{
+	// Built once, shared by every item mesh
+	static const TArray<FItemCollisionProfile> Profiles = []
+	{
+		TArray<FItemCollisionProfile> Table;
+		Table.SetNum(static_cast<int32>(EItemState::EIS_Max));
+		for(FItemCollisionProfile& Profile : Table)
+		{
+			Profile.Responses.SetAllChannels(ECollisionResponse::ECR_Ignore);
+		}
+		FItemCollisionProfile& Falling = Table[static_cast<int32>(EItemState::EIS_Falling)];
+		Falling.CollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+		Falling.Responses.SetResponse(ECollisionChannel::ECC_WorldStatic, ECollisionResponse::ECR_Block);
+		Falling.bSimulatePhysics = true;
+		Falling.bEnableGravity = true;
+		Table[static_cast<int32>(EItemState::EIS_PickedUp)].bVisible = false;
+		return Table;
+	}();
+	return Profiles[static_cast<int32>(State)];
+}
+
+const FItemCollisionProfile& AItem::GetCollisionBoxProfile(EItemState State)
+{
+	// Built once, the box only blocks visibility traces while the item can be picked up
+	static const TArray<FItemCollisionProfile> Profiles = []
+	{
+		TArray<FItemCollisionProfile> Table;
+		Table.SetNum(static_cast<int32>(EItemState::EIS_Max));
+		for(FItemCollisionProfile& Profile : Table)
+		{
+			Profile.Responses.SetAllChannels(ECollisionResponse::ECR_Ignore);
+		}
+		FItemCollisionProfile& Pickup = Table[static_cast<int32>(EItemState::EIS_Pickup)];
+		Pickup.CollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+		Pickup.Responses.SetResponse(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
+		return Table;
+	}();
+	return Profiles[static_cast<int32>(State)];
+}
+
+void AItem::ApplyCollisionProfile(UPrimitiveComponent* Component, const FItemCollisionProfile& Profile)
+{
+	if(Component == nullptr) return;
+
+	// Each setter may recreate the physics state, only call the ones that change something
+	if(!Profile.bSimulatePhysics && Component -> IsSimulatingPhysics())
+	{
+		INC_DWORD_STAT(STAT_ItemCollisionChanges);
+		Component -> SetSimulatePhysics(false);
+	}
+	const FCollisionResponseContainer& Responses = Component -> GetCollisionResponseToChannels();
+	if(FMemory::Memcmp(Responses.EnumArray, Profile.Responses.EnumArray, sizeof(Responses.EnumArray)) != 0)
+	{
+		INC_DWORD_STAT(STAT_ItemCollisionChanges);
+		Component -> SetCollisionResponseToChannels(Profile.Responses);
+	}
+	if(Component -> GetCollisionEnabled() != Profile.CollisionEnabled)
+	{
+		INC_DWORD_STAT(STAT_ItemCollisionChanges);
+		Component -> SetCollisionEnabled(Profile.CollisionEnabled);
+	}
+	if(Profile.bSimulatePhysics && !Component -> IsSimulatingPhysics())
+	{
+		INC_DWORD_STAT(STAT_ItemCollisionChanges);
+		Component -> SetSimulatePhysics(true);
+	}
+	if(Component -> IsGravityEnabled() != Profile.bEnableGravity)
+	{
+		Component -> SetEnableGravity(Profile.bEnableGravity);
+	}
+	if(Component -> IsVisible() != Profile.bVisible)
+	{
+		Component -> SetVisibility(Profile.bVisible);
+	}
+}
+
 void AItem::UpdateItemProperties(EItemState State)
 {
 	if(!ItemMesh || !PickupWidget) return;
-	switch(State)
+	if(State == EItemState::EIS_EquipInterp || State == EItemState::EIS_Equipped)
 	{
-	case EItemState::EIS_Pickup:
-		ItemMesh -> SetSimulatePhysics(false);
-		ItemMesh -> SetEnableGravity(false);
-		ItemMesh -> SetVisibility(true);
-		ItemMesh -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		ItemMesh -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		CollisionBox -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		CollisionBox -> SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
-		CollisionBox -> SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		AreaSphere -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
-		AreaSphere -> SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-		break;
-	case EItemState::EIS_EquipInterp:
-		PickupWidget -> SetVisibility(false);
-		ItemMesh -> SetSimulatePhysics(false);
-		ItemMesh -> SetEnableGravity(false);
-		ItemMesh -> SetVisibility(true);
-		ItemMesh -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		ItemMesh -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		CollisionBox -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		CollisionBox -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		AreaSphere -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AreaSphere -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	case EItemState::EIS_Equipped:
 		PickupWidget -> SetVisibility(false);
-		ItemMesh -> SetSimulatePhysics(false);
-		ItemMesh -> SetEnableGravity(false);
-		ItemMesh -> SetVisibility(true);
-		ItemMesh -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		ItemMesh -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		CollisionBox -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		CollisionBox -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		AreaSphere -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AreaSphere -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	case EItemState::EIS_Falling:
-		ItemMesh -> SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		ItemMesh -> SetSimulatePhysics(true);
-		ItemMesh -> SetEnableGravity(true);
-		ItemMesh -> SetVisibility(true);
-		ItemMesh -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		ItemMesh -> SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldStatic, ECollisionResponse::ECR_Block);
-		CollisionBox -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		CollisionBox -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		AreaSphere -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AreaSphere -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
-	case EItemState::EIS_PickedUp:
-		ItemMesh -> SetSimulatePhysics(false);
-		ItemMesh -> SetEnableGravity(false);
-		ItemMesh -> SetVisibility(false);
-		ItemMesh -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		ItemMesh -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		CollisionBox -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		CollisionBox -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		AreaSphere -> SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-		AreaSphere -> SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		break;
 	}
+	ApplyCollisionProfile(ItemMesh, GetMeshCollisionProfile(State));
+	ApplyCollisionProfile(CollisionBox, GetCollisionBoxProfile(State));
 }
 
 void AItem::StartPickingItem(AShooterCharacter* Char, bool bForcePlay)
@@ -213,6 +261,8 @@ void AItem::StartPickingItem(AShooterCharacter* Char, bool bForcePlay)
 	PlayPickupSound(bForcePlay);
 	
 	ItemInterpStartLocation = GetActorLocation();
+	BakedItemZCurve = UBakedCurveSubsystem::FindOrBakeCurve(this, ItemZCurve);
+	BakedItemScaleCurve = UBakedCurveSubsystem::FindOrBakeCurve(this, ItemScaleCurve);
 	bInterping = true;
 	SetItemState(EItemState::EIS_EquipInterp);
 
@@ -230,13 +280,16 @@ void AItem::FinishInterping()
 {
 	bInterping = false;
 	GetWorldTimerManager().ClearTimer(InterpCurveTimer);
+	RefreshTickEnabled();
 	
-	if(Character)
+	// Picking the item up may hand it back to the pool, which clears Character
+	AShooterCharacter* PickingCharacter{ Character };
+	if(PickingCharacter)
 	{
-		Character -> PickupItem(this);
+		PickingCharacter -> PickupItem(this);
 		// Subtract 1 from the ItemCount of this InterpLocation struct
-		Character -> IncrementInterpLocItemCount(InterpLocationIndex, -1);
-		Character -> UnHighlightInventorySlot();
+		PickingCharacter -> IncrementInterpLocItemCount(InterpLocationIndex, -1);
+		PickingCharacter -> UnHighlightInventorySlot();
 	}
 	if(ItemScaleCurve) SetActorScale3D(FVector(1.f)); // Set scale back to normal
 
@@ -251,7 +304,7 @@ void AItem::PickupInterpHandler(float DeltaTime)
 	if(Character && ItemZCurve)
 	{
 		const float ElapsedTime = GetWorldTimerManager().GetTimerElapsed(InterpCurveTimer);
-		const float ZCurveValue = ItemZCurve -> GetFloatValue(ElapsedTime);
+		const float ZCurveValue = UBakedCurveSubsystem::Evaluate(BakedItemZCurve, ItemZCurve, ElapsedTime);
 
 		FVector ItemCurrentLocation = ItemInterpStartLocation;
 		FVector TargetInterpLocation{FVector(0.f)};
@@ -285,7 +338,7 @@ void AItem::PickupInterpHandler(float DeltaTime)
 
 		if(ItemScaleCurve) // Applying a ScaleCurve is optional
 		{
-			const float ScaleCurveValue = ItemScaleCurve -> GetFloatValue(ElapsedTime);
+			const float ScaleCurveValue = UBakedCurveSubsystem::Evaluate(BakedItemScaleCurve, ItemScaleCurve, ElapsedTime);
 			SetActorScale3D(FVector(ScaleCurveValue) * FVector(InterpSizeScale));
 		}
 	}
@@ -329,6 +382,11 @@ void AItem::PlayPickupSound(bool bForceplay) const
 	}
 }
 
+FVector AItem::GetPickupLocation() const
+{
+	return CollisionBox ? CollisionBox -> Bounds.Origin : GetActorLocation();
+}
+
 void AItem::EnableGlowMaterial() const
 {
 	if(GlowMaterialInstanceDynamic)
@@ -386,19 +444,28 @@ void AItem::GlowPulseHandler() const
 	case EItemState::EIS_Pickup:
 		if(GlowPulseCurve)
 		{
-			ElapsedTime = GetWorldTimerManager().GetTimerElapsed(GlowPulseTimer);
-			GlowPulseVector = GlowPulseCurve -> GetVectorValue(ElapsedTime);
+			ElapsedTime = GetGlowPulseTime();
+			GlowPulseVector = UBakedCurveSubsystem::Evaluate(BakedGlowPulseCurve, GlowPulseCurve, ElapsedTime);
 		}
 		break;
 	case EItemState::EIS_EquipInterp:
 		if(GlowPulseInterpCurve)
 		{
 			ElapsedTime = GetWorldTimerManager().GetTimerElapsed(InterpCurveTimer);
-			GlowPulseVector = GlowPulseInterpCurve ->GetVectorValue(ElapsedTime);
+			GlowPulseVector = UBakedCurveSubsystem::Evaluate(BakedGlowPulseInterpCurve, GlowPulseInterpCurve, ElapsedTime);
 		}
 		break;
 	}
+	ApplyGlowPulse(GlowPulseVector);
+}
+
+float AItem::GetGlowPulseTime() const
+{
+	return GetWorldTimerManager().GetTimerElapsed(GlowPulseTimer);
+}
 
+void AItem::ApplyGlowPulse(const FVector& GlowPulseVector) const
+{
 	if(GlowMaterialInstanceDynamic) // Assign the values to GlowPulse material instance
 	{
 		GlowMaterialInstanceDynamic -> SetScalarParameterValue(GlowAmountParameterName,
@@ -444,6 +511,51 @@ void AItem::LoadRarityData()
 	}
 }
 
+bool AItem::ShouldTick() const
+{
+	return bInterping;
+}
+
+bool AItem::IsGlowPulsing() const
+{
+	const bool bPulsing{ ItemState == EItemState::EIS_Pickup && GlowPulseCurve && GlowMaterialInstanceDynamic };
+	return bPulsing && ItemMesh && ItemMesh -> IsVisible();
+}
+
+void AItem::RefreshTickEnabled()
+{
+	// Items on the ground pulse in one batch per curve, without a tick of their own
+	const bool bGlowPulsing{ IsGlowPulsing() && BakedGlowPulseCurve };
+	if(bGlowPulsing != bGlowPulseRegistered)
+	{
+		if(UItemGlowSubsystem* ItemGlow = GetWorld() ? GetWorld() -> GetSubsystem<UItemGlowSubsystem>() : nullptr)
+		{
+			if(bGlowPulsing)
+			{
+				ItemGlow -> RegisterItem(this, BakedGlowPulseCurve);
+			}
+			else
+			{
+				ItemGlow -> UnregisterItem(this);
+			}
+			bGlowPulseRegistered = bGlowPulsing;
+		}
+	}
+
+	const bool bShouldTick{ ShouldTick() };
+	if(bShouldTick == IsActorTickEnabled()) return;
+
+	SetActorTickEnabled(bShouldTick);
+	if(bShouldTick)
+	{
+		INC_DWORD_STAT(STAT_ActiveItemTicks);
+	}
+	else
+	{
+		DEC_DWORD_STAT(STAT_ActiveItemTicks);
+	}
+}
+
 // Called every frame
 void AItem::Tick(float DeltaTime)
 {
@@ -459,6 +571,8 @@ void AItem::SetItemState(EItemState State)
 {
 	ItemState = State;
 	UpdateItemProperties(State);
+	UpdatePickupRegistration();
+	RefreshTickEnabled();
 }
 
 void AItem::PlayEquipSound(bool bForcePlay) const
@@ -499,3 +613,23 @@ void AItem::DisableCustomDepth()
 		ItemMesh -> SetRenderCustomDepth(false);
 	}
 }
+
+void AItem::OnAcquiredFromPool()
+{
+	SetActorScale3D(FVector(1.f));
+	InitializeCustomDepth();
+	// Picking the item up disabled the glow and cleared the pulse timer.
+	// The pool sets the pickup state after this, so the timer is started without checking the state
+	EnableGlowMaterial();
+	GetWorldTimerManager().SetTimer(GlowPulseTimer, this, &AItem::ResetGlowPulseTimer, GlowPulseDuration);
+}
+
+void AItem::OnReleasedToPool()
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	bInterping = false;
+	Character = nullptr;
+	if(PickupWidget) PickupWidget -> SetVisibility(false);
+	DisableCustomDepth();
+	RefreshTickEnabled();
+}
@@ -31,6 +31,16 @@ enum class EItemState : uint8
 	EIS_Max UMETA(DisplayName = "DefaultMax")
 };
 
+/** Collision, physics and visibility of an item component in one EItemState */
+struct FItemCollisionProfile
+{
+	ECollisionEnabled::Type CollisionEnabled{ ECollisionEnabled::NoCollision };
+	FCollisionResponseContainer Responses;
+	bool bSimulatePhysics{ false };
+	bool bEnableGravity{ false };
+	bool bVisible{ true };
+};
+
 UENUM(BlueprintType)
 enum class EItemType : uint8
 {
@@ -77,15 +87,10 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-	/** Called when overlapping AreaSphere */
-	UFUNCTION()
-	void OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex, bool bFromSweep, const FHitResult &SweepResult);
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-	/** Called when overlapping AreaSphere ends */
-	UFUNCTION()
-	void OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex);
+	/** Register the item in the world's item registry while it can be picked up, unregister it otherwise */
+	void UpdatePickupRegistration();
 
 	/** Set the ActiveStars array of bools based on the rarity */
 	void SetActiveStars();
@@ -93,6 +98,13 @@ protected:
 	/** Set properties for Item's components based on the State */
 	virtual void UpdateItemProperties(EItemState State);
 
+	/** Profiles of the item meshes and the CollisionBox for each state, built once */
+	static const FItemCollisionProfile& GetMeshCollisionProfile(EItemState State);
+	static const FItemCollisionProfile& GetCollisionBoxProfile(EItemState State);
+
+	/** Switch the component to the profile, skipping everything already matching it */
+	static void ApplyCollisionProfile(UPrimitiveComponent* Component, const FItemCollisionProfile& Profile);
+
 	/** Called when item interpolation is finished */
 	void FinishInterping();
 
@@ -113,11 +125,21 @@ protected:
 
 	void ResetGlowPulseTimer();
 
-	/** Handle item's GlowPulse */	
+	/** Handle item's GlowPulse while interping, the UItemGlowSubsystem pulses items on the ground */	
 	void GlowPulseHandler() const;
 
 	/** Load and populate Rarity variables from the ItemRarityDataTable class provided */
 	void LoadRarityData();
+
+	/** True while the item has per-frame work of its own, like interping */
+	virtual bool ShouldTick() const;
+
+	/** True while the item pulses its glow, visible on the ground */
+	bool IsGlowPulsing() const;
+
+	/** Enable the tick only while ShouldTick, and hand the glow to the UItemGlowSubsystem only while IsGlowPulsing.
+	 *  Call it whenever something either depends on changes */
+	void RefreshTickEnabled();
 	
 public:	
 	// Called every frame
@@ -198,6 +220,10 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	UCurveFloat* ItemScaleCurve;
 
+	/** Lookup tables of the interp curves, shared with every item using the same curve assets */
+	const struct FBakedCurve* BakedItemZCurve;
+	const FBakedCurve* BakedItemScaleCurve;
+
 	/** Sound to play when picking item */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item Properties", meta = (AllowPrivateAccess = "true"))
 	class USoundCue* PickupSound;
@@ -283,6 +309,13 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = GlowMaterial, meta = (AllowPrivateAccess = "true"))
 	float GlowPulseDuration;
 
+	/** Lookup tables of the glow curves, shared with every item using the same curve assets */
+	const struct FBakedVectorCurve* BakedGlowPulseCurve;
+	const FBakedVectorCurve* BakedGlowPulseInterpCurve;
+
+	/** True while the UItemGlowSubsystem pulses our glow */
+	bool bGlowPulseRegistered;
+
 	/** Item icon for this item in the inventory */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = "true"))
 	UTexture2D* ItemIcon;
@@ -360,13 +393,28 @@ public:
 
 	void PlayEquipSound(bool bForcePlay = false) const;
 
+	/** Center of the CollisionBox, the actor location sits at the bottom of an item resting on the floor */
+	FVector GetPickupLocation() const;
+
 	void EnableGlowMaterial() const;
 	
 	void DisableGlowMaterial() const;
+
+	/** Time into the current GlowPulseCurve cycle */
+	float GetGlowPulseTime() const;
+
+	/** Write a glow curve value into the glow material parameters */
+	void ApplyGlowPulse(const FVector& GlowPulse) const;
 	
 	/** Enable outline post-process */
 	virtual void EnableCustomDepth();
 
 	/** Disable outline post-process */
 	virtual void DisableCustomDepth();
+
+	/** Called by the item pool before handing the item out again, before it enters EIS_Pickup */
+	virtual void OnAcquiredFromPool();
+
+	/** Called by the item pool once the item is back in EIS_PickedUp, clears what it was doing */
+	virtual void OnReleasedToPool();
 };
@@ -0,0 +1,93 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "ItemGlowSubsystem.h"
+
+#include "BakedCurveSubsystem.h"
+#include "Item.h"
+#include "Shooter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Item Glow Pulse"), STAT_ItemGlowPulse, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pulsing Items"), STAT_PulsingItems, STATGROUP_Shooter);
+
+void UItemGlowSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UItemGlowSubsystem::OnWorldPreActorTick);
+}
+
+void UItemGlowSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	Groups.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UItemGlowSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UItemGlowSubsystem::RegisterItem(AItem* Item, const FBakedVectorCurve* Curve)
+{
+	if(Item == nullptr || Curve == nullptr) return;
+	UnregisterItem(Item);
+
+	FItemGlowPulseGroup* Group = Groups.FindByPredicate([Curve](const FItemGlowPulseGroup& Entry)
+	{
+		return Entry.Curve == Curve;
+	});
+	if(Group == nullptr)
+	{
+		Group = &Groups.AddDefaulted_GetRef();
+		Group -> Curve = Curve;
+	}
+	Group -> Items.Add(Item);
+}
+
+void UItemGlowSubsystem::UnregisterItem(AItem* Item)
+{
+	for(int32 i = 0; i < Groups.Num(); i++)
+	{
+		if(Groups[i].Items.RemoveSingleSwap(Item) == 0) continue;
+
+		if(Groups[i].Items.Num() == 0)
+		{
+			Groups.RemoveAtSwap(i);
+		}
+		return;
+	}
+}
+
+void UItemGlowSubsystem::OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	// The delegate is shared by every world, only handle our own
+	if(World != GetWorld() || Groups.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_ItemGlowPulse);
+
+	for(FItemGlowPulseGroup& Group : Groups)
+	{
+		// Destroyed without unregistering
+		Group.Items.RemoveAllSwap([](const AItem* Item) { return !IsValid(Item); });
+
+		const int32 NumItems{ Group.Items.Num() };
+		PulseTimes.Reset();
+		PulseTimes.AddUninitialized(NumItems);
+		PulseValues.Reset();
+		PulseValues.AddUninitialized(NumItems);
+
+		for(int32 i = 0; i < NumItems; i++)
+		{
+			PulseTimes[i] = Group.Items[i] -> GetGlowPulseTime();
+		}
+		Group.Curve -> EvaluateBatch(PulseTimes, PulseValues);
+		for(int32 i = 0; i < NumItems; i++)
+		{
+			Group.Items[i] -> ApplyGlowPulse(PulseValues[i]);
+		}
+		INC_DWORD_STAT_BY(STAT_PulsingItems, NumItems);
+	}
+}
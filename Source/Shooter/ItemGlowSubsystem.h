@@ -0,0 +1,56 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemGlowSubsystem.generated.h"
+
+class AItem;
+struct FBakedVectorCurve;
+
+/** Items pulsing along the same glow curve */
+USTRUCT()
+struct FItemGlowPulseGroup
+{
+	GENERATED_BODY()
+
+	const FBakedVectorCurve* Curve{ nullptr };
+
+	UPROPERTY()
+	TArray<AItem*> Items;
+};
+
+/**
+ * Pulses the glow of every item lying in the world, instead of each item ticking for it.
+ * Items sharing a glow curve are evaluated in one batch against the curve's baked lookup table.
+ */
+UCLASS()
+class SHOOTER_API UItemGlowSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Pulse the item's glow along the baked curve every frame */
+	void RegisterItem(AItem* Item, const FBakedVectorCurve* Curve);
+
+	void UnregisterItem(AItem* Item);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	FDelegateHandle PreActorTickHandle;
+
+	UPROPERTY()
+	TArray<FItemGlowPulseGroup> Groups;
+
+	/** Batch buffers, kept between frames so they don't reallocate */
+	TArray<float> PulseTimes;
+	TArray<FVector> PulseValues;
+};
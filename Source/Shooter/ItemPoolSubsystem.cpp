@@ -0,0 +1,115 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "ItemPoolSubsystem.h"
+
+#include "Item.h"
+#include "Shooter.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Items"), STAT_PooledItems, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Pool Hits"), STAT_ItemPoolHits, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Pool Spawns"), STAT_ItemPoolSpawns, STATGROUP_Shooter);
+
+void UItemPoolSubsystem::Deinitialize()
+{
+	for(const auto& Pair : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_PooledItems, Pair.Value.FreeItems.Num());
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UItemPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UItemPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	for(const auto& Pair : PrewarmCounts)
+	{
+		Prewarm(Pair.Key.LoadSynchronous(), Pair.Value);
+	}
+}
+
+AItem* UItemPoolSubsystem::SpawnItem(TSubclassOf<AItem> ItemClass, const FTransform& Transform)
+{
+	INC_DWORD_STAT(STAT_ItemPoolSpawns);
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return GetWorld() -> SpawnActor<AItem>(ItemClass, Transform, SpawnParameters);
+}
+
+AItem* UItemPoolSubsystem::AcquireItem(TSubclassOf<AItem> ItemClass, const FTransform& Transform)
+{
+	if(ItemClass == nullptr) return nullptr;
+
+	AItem* Item{ nullptr };
+	if(FItemPool* Pool = Pools.Find(ItemClass.Get()))
+	{
+		while(Item == nullptr && Pool -> FreeItems.Num() > 0)
+		{
+			AItem* FreeItem = Pool -> FreeItems.Pop();
+			DEC_DWORD_STAT(STAT_PooledItems);
+			if(IsValid(FreeItem)) Item = FreeItem; // Skip items destroyed while pooled
+		}
+	}
+
+	if(Item == nullptr)
+	{
+		return SpawnItem(ItemClass, Transform);
+	}
+
+	INC_DWORD_STAT(STAT_ItemPoolHits);
+	Item -> SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	Item -> SetActorHiddenInGame(false);
+	Item -> SetActorEnableCollision(true);
+	Item -> OnAcquiredFromPool();
+	Item -> SetItemState(EItemState::EIS_Pickup);
+	return Item;
+}
+
+void UItemPoolSubsystem::ReleaseItem(AItem* Item)
+{
+	if(!IsValid(Item)) return;
+
+	Item -> DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	Item -> SetOwner(nullptr);
+	Item -> SetItemState(EItemState::EIS_PickedUp);
+	Item -> OnReleasedToPool();
+	Item -> SetActorHiddenInGame(true);
+	Item -> SetActorEnableCollision(false);
+
+	Pools.FindOrAdd(Item -> GetClass()).FreeItems.Add(Item);
+	INC_DWORD_STAT(STAT_PooledItems);
+}
+
+void UItemPoolSubsystem::Prewarm(TSubclassOf<AItem> ItemClass, int32 Count)
+{
+	if(ItemClass == nullptr) return;
+
+	const int32 FreeCount{ Pools.FindOrAdd(ItemClass.Get()).FreeItems.Num() };
+	for(int32 i = FreeCount; i < Count; i++)
+	{
+		ReleaseItem(SpawnItem(ItemClass, FTransform::Identity));
+	}
+}
+
+void UItemPoolSubsystem::ReleasePooledItem(AItem* Item)
+{
+	if(!IsValid(Item)) return;
+
+	UItemPoolSubsystem* ItemPool = Item -> GetWorld() -> GetSubsystem<UItemPoolSubsystem>();
+	if(ItemPool)
+	{
+		ItemPool -> ReleaseItem(Item);
+	}
+	else
+	{
+		Item -> Destroy();
+	}
+}
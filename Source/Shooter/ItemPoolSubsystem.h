@@ -0,0 +1,67 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemPoolSubsystem.generated.h"
+
+class AItem;
+
+/** Inactive items of a single class, waiting to be handed out */
+USTRUCT()
+struct FItemPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AItem*> FreeItems;
+};
+
+/**
+ * Keeps released weapons and ammo around instead of destroying them, and hands them out again
+ * instead of spawning, so pickups and drops don't pay for actor construction and garbage collection.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UItemPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Take an item of the class out of the pool, spawns one if the pool is empty
+	 *  @return The item in EIS_Pickup state at the given transform
+	 */
+	AItem* AcquireItem(TSubclassOf<AItem> ItemClass, const FTransform& Transform);
+
+	template<typename T>
+	T* AcquireItem(TSubclassOf<T> ItemClass, const FTransform& Transform)
+	{
+		return Cast<T>(AcquireItem(TSubclassOf<AItem>(ItemClass.Get()), Transform));
+	}
+
+	/** Hide the item and keep it for the next AcquireItem of its class */
+	void ReleaseItem(AItem* Item);
+
+	/** Spawn items up front, so the first pickups and drops don't pay for them */
+	void Prewarm(TSubclassOf<AItem> ItemClass, int32 Count);
+
+	/** Release the item to the world's pool, destroys it if the world has none */
+	static void ReleasePooledItem(AItem* Item);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	AItem* SpawnItem(TSubclassOf<AItem> ItemClass, const FTransform& Transform);
+
+	UPROPERTY()
+	TMap<UClass*, FItemPool> Pools;
+
+	/** Number of items created per class when the world begins play */
+	UPROPERTY(Config)
+	TMap<TSoftClassPtr<AItem>, int32> PrewarmCounts;
+};
@@ -0,0 +1,124 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "ItemRegistrySubsystem.h"
+
+#include "Item.h"
+#include "Shooter.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Find Pickup Item"), STAT_FindPickupItem, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup Items Tested"), STAT_PickupItemsTested, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Pickup Items"), STAT_RegisteredPickupItems, STATGROUP_Shooter);
+
+void UItemRegistrySubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_RegisteredPickupItems, ItemCells.Num());
+	Cells.Empty();
+	ItemCells.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UItemRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FIntVector UItemRegistrySubsystem::GetCellCoordinates(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+void UItemRegistrySubsystem::RegisterItem(AItem* Item, float PickupRadius)
+{
+	if(Item == nullptr) return;
+	UnregisterItem(Item);
+
+	FRegisteredItem Entry;
+	Entry.Item = Item;
+	Entry.Location = Item -> GetPickupLocation();
+	Entry.PickupRadius = PickupRadius;
+
+	const FIntVector CellCoordinates{ GetCellCoordinates(Entry.Location) };
+	Cells.FindOrAdd(CellCoordinates).Items.Add(Entry);
+	ItemCells.Add(FObjectKey(Item), CellCoordinates);
+	MaxPickupRadius = FMath::Max(MaxPickupRadius, PickupRadius);
+	INC_DWORD_STAT(STAT_RegisteredPickupItems);
+}
+
+void UItemRegistrySubsystem::UnregisterItem(AItem* Item)
+{
+	FIntVector CellCoordinates;
+	if(!ItemCells.RemoveAndCopyValue(FObjectKey(Item), CellCoordinates)) return;
+
+	if(FItemGridCell* Cell = Cells.Find(CellCoordinates))
+	{
+		Cell -> Items.RemoveAllSwap([Item](const FRegisteredItem& Entry) { return Entry.Item == Item; });
+		if(Cell -> Items.Num() == 0)
+		{
+			Cells.Remove(CellCoordinates);
+		}
+	}
+	DEC_DWORD_STAT(STAT_RegisteredPickupItems);
+}
+
+AItem* UItemRegistrySubsystem::FindBestItemInView(const FVector& PawnLocation, float PawnRadius,
+	const FVector& ViewLocation, const FVector& ViewDirection, float MinViewDot, const AActor* Pawn) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_FindPickupItem);
+	if(ItemCells.Num() == 0) return nullptr;
+
+	// Only cells an item could reach the pawn from
+	const FVector Reach{ FVector(PawnRadius + MaxPickupRadius) };
+	const FIntVector MinCell{ GetCellCoordinates(PawnLocation - Reach) };
+	const FIntVector MaxCell{ GetCellCoordinates(PawnLocation + Reach) };
+
+	// Other items' CollisionBoxes block visibility, they'd hide the winner from the occlusion trace
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(PickupItemVisibility));
+	QueryParams.AddIgnoredActor(Pawn);
+
+	AItem* BestItem{ nullptr };
+	FVector BestLocation{ FVector::ZeroVector };
+	float BestViewDot{ MinViewDot };
+	for(int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for(int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for(int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const FItemGridCell* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if(Cell == nullptr) continue;
+
+				INC_DWORD_STAT_BY(STAT_PickupItemsTested, Cell -> Items.Num());
+				for(const FRegisteredItem& Entry : Cell -> Items)
+				{
+					QueryParams.AddIgnoredActor(Entry.Item);
+
+					// Is the pawn inside the item's pickup radius?
+					const float Range{ Entry.PickupRadius + PawnRadius };
+					if(FVector::DistSquared(PawnLocation, Entry.Location) > FMath::Square(Range)) continue;
+
+					// Is the item inside the view cone, and closer to its center than the best so far?
+					const FVector ToItem{ (Entry.Location - ViewLocation).GetSafeNormal() };
+					const float ViewDot{ FVector::DotProduct(ToItem, ViewDirection) };
+					if(ViewDot >= BestViewDot)
+					{
+						BestViewDot = ViewDot;
+						BestItem = Entry.Item;
+						BestLocation = Entry.Location;
+					}
+				}
+			}
+		}
+	}
+	if(BestItem == nullptr) return nullptr;
+
+	// One occlusion trace, for the winner only
+	const bool bOccluded{ GetWorld() -> LineTraceTestByChannel(ViewLocation, BestLocation,
+		ECC_Visibility, QueryParams) };
+	return bOccluded ? nullptr : BestItem;
+}
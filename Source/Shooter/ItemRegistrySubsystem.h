@@ -0,0 +1,82 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ItemRegistrySubsystem.generated.h"
+
+class AItem;
+
+/** An item lying in the world, waiting to be picked up */
+USTRUCT()
+struct FRegisteredItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AItem* Item{ nullptr };
+
+	/** Pickup location of the item when it was registered, pickup items don't move */
+	FVector Location{ FVector::ZeroVector };
+
+	/** Distance from which the item can be picked up */
+	float PickupRadius{ 0.f };
+};
+
+/** Items whose location falls inside a single grid cell */
+USTRUCT()
+struct FItemGridCell
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FRegisteredItem> Items;
+};
+
+/**
+ * Uniform grid of the items that can currently be picked up.
+ * Answers "best item in the view cone within pickup range" without physics traces or per-item overlap spheres.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UItemRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Add the item to the grid, moves it if it was already registered */
+	void RegisterItem(AItem* Item, float PickupRadius);
+
+	void UnregisterItem(AItem* Item);
+
+	/** Find the item closest to the view direction, among the items whose pickup radius reaches the pawn.
+	 *  The winner gets a single visibility trace to its center, an item behind a wall is not returned.
+	 *  Items near the pawn don't block the trace.
+	 *  @param MinViewDot Cosine of the half angle of the view cone
+	 *  @param Pawn Ignored by the visibility trace
+	 */
+	AItem* FindBestItemInView(const FVector& PawnLocation, float PawnRadius, const FVector& ViewLocation,
+		const FVector& ViewDirection, float MinViewDot, const AActor* Pawn = nullptr) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FIntVector GetCellCoordinates(const FVector& Location) const;
+
+	UPROPERTY()
+	TMap<FIntVector, FItemGridCell> Cells;
+
+	/** Registered item -> cell it lives in */
+	TMap<FObjectKey, FIntVector> ItemCells;
+
+	/** Largest pickup radius registered, bounds how many cells a query visits */
+	float MaxPickupRadius{ 0.f };
+
+	/** Edge length of a grid cell */
+	UPROPERTY(Config)
+	float CellSize{ 1000.f };
+};
@@ -0,0 +1,143 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "ParticlePoolSubsystem.h"
+
+#include "Shooter.h"
+#include "GameFramework/WorldSettings.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Particle Components"), STAT_PooledParticleComponents, STATGROUP_Shooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Particle Spawns"), STAT_PooledParticleSpawns, STATGROUP_Shooter);
+
+void UParticlePoolSubsystem::Deinitialize()
+{
+	for(const auto& Pair : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_PooledParticleComponents,
+			Pair.Value.FreeComponents.Num() + Pair.Value.ActiveComponents.Num());
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UParticlePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+UParticleSystemComponent* UParticlePoolSubsystem::SpawnEmitterAtLocation(UParticleSystem* Template,
+	const FTransform& Transform)
+{
+	if(Template == nullptr) return nullptr;
+	INC_DWORD_STAT(STAT_PooledParticleSpawns);
+
+	FParticlePool& Pool = FindOrAddPool(Template);
+	UParticleSystemComponent* Component = nullptr;
+
+	// Drop components destroyed along with their outer
+	while(Pool.FreeComponents.Num() > 0 && Component == nullptr)
+	{
+		Component = Pool.FreeComponents.Pop();
+		if(!IsValid(Component)) Component = nullptr;
+	}
+	if(Component == nullptr)
+	{
+		if(Pool.ActiveComponents.Num() + Pool.FreeComponents.Num() < Pool.MaxComponents)
+		{
+			Component = CreateComponent(Template);
+		}
+		else if(Pool.ActiveComponents.Num() > 0)
+		{
+			// Pool is at its cap, recycle the oldest playing component. It's removed from the active
+			// list first, so OnParticleSystemFinished doesn't send it back to the free list.
+			Component = Pool.ActiveComponents[0];
+			Pool.ActiveComponents.RemoveAt(0);
+			Component -> DeactivateImmediate();
+		}
+	}
+	if(!IsValid(Component)) return nullptr;
+
+	Component -> SetWorldTransform(Transform);
+	Component -> ActivateSystem(true);
+	Pool.ActiveComponents.Add(Component);
+	return Component;
+}
+
+UParticleSystemComponent* UParticlePoolSubsystem::SpawnPooledEmitter(const UObject* WorldContextObject,
+	UParticleSystem* Template, const FTransform& Transform)
+{
+	if(Template == nullptr || WorldContextObject == nullptr) return nullptr;
+
+	const UWorld* World = WorldContextObject -> GetWorld();
+	UParticlePoolSubsystem* ParticlePool = World ? World -> GetSubsystem<UParticlePoolSubsystem>() : nullptr;
+	if(ParticlePool)
+	{
+		return ParticlePool -> SpawnEmitterAtLocation(Template, Transform);
+	}
+	return UGameplayStatics::SpawnEmitterAtLocation(WorldContextObject, Template, Transform);
+}
+
+void UParticlePoolSubsystem::Prewarm(UParticleSystem* Template, int32 Count)
+{
+	if(Template == nullptr) return;
+	
+	FParticlePool& Pool = FindOrAddPool(Template);
+	const int32 TargetCount{ FMath::Min(Count < 0 ? DefaultPrewarmCount : Count, Pool.MaxComponents) };
+	while(Pool.FreeComponents.Num() + Pool.ActiveComponents.Num() < TargetCount)
+	{
+		UParticleSystemComponent* Component = CreateComponent(Template);
+		if(Component == nullptr) return;
+		Pool.FreeComponents.Add(Component);
+	}
+}
+
+void UParticlePoolSubsystem::SetTemplateCap(UParticleSystem* Template, int32 Cap)
+{
+	if(Template == nullptr) return;
+	FindOrAddPool(Template).MaxComponents = FMath::Max(Cap, 1);
+}
+
+FParticlePool& UParticlePoolSubsystem::FindOrAddPool(UParticleSystem* Template)
+{
+	FParticlePool* Pool = Pools.Find(Template);
+	if(Pool == nullptr)
+	{
+		Pool = &Pools.Add(Template);
+		Pool -> MaxComponents = FMath::Max(DefaultMaxComponentsPerTemplate, 1);
+	}
+	return *Pool;
+}
+
+UParticleSystemComponent* UParticlePoolSubsystem::CreateComponent(UParticleSystem* Template)
+{
+	UWorld* World = GetWorld();
+	if(World == nullptr || World -> GetWorldSettings() == nullptr) return nullptr;
+
+	UParticleSystemComponent* Component = NewObject<UParticleSystemComponent>(World -> GetWorldSettings());
+	Component -> bAutoDestroy = false;
+	Component -> bAutoActivate = false;
+	Component -> bAllowRecycling = true;
+	Component -> SecondsBeforeInactive = 0.f;
+	Component -> SetTemplate(Template);
+	Component -> SetAbsolute(true, true, true);
+	Component -> OnSystemFinished.AddDynamic(this, &UParticlePoolSubsystem::OnParticleSystemFinished);
+	Component -> RegisterComponentWithWorld(World);
+
+	INC_DWORD_STAT(STAT_PooledParticleComponents);
+	return Component;
+}
+
+void UParticlePoolSubsystem::OnParticleSystemFinished(UParticleSystemComponent* Component)
+{
+	if(Component == nullptr) return;
+
+	FParticlePool* Pool = Pools.Find(Component -> Template);
+	if(Pool && Pool -> ActiveComponents.RemoveSingle(Component) > 0)
+	{
+		Pool -> FreeComponents.Add(Component);
+	}
+}
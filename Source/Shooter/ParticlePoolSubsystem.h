@@ -0,0 +1,81 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ParticlePoolSubsystem.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+/** Components spawned for a single particle template */
+USTRUCT()
+struct FParticlePool
+{
+	GENERATED_BODY()
+
+	/** Components ready to be handed out */
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> FreeComponents;
+
+	/** Components currently playing, oldest first */
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> ActiveComponents;
+
+	/** Maximum number of components this template may own */
+	int32 MaxComponents{ 0 };
+};
+
+/**
+ * Keeps pre-warmed pools of particle system components per template, so frequent effects
+ * (muzzle flash, impacts, beams, blood) don't create and register a new component every time.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UParticlePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Play a pooled emitter, the component returns to the pool once it finishes
+	 *  @return The playing component, only valid until its system finishes
+	 */
+	UParticleSystemComponent* SpawnEmitterAtLocation(UParticleSystem* Template, const FTransform& Transform);
+
+	/** Spawn from the world's particle pool, falls back to UGameplayStatics when the world has no pool */
+	static UParticleSystemComponent* SpawnPooledEmitter(const UObject* WorldContextObject, UParticleSystem* Template,
+		const FTransform& Transform);
+
+	/** Create components up front so the first shots don't pay for them
+	 *  @param Count Number of components to keep ready, DefaultPrewarmCount if negative
+	 */
+	void Prewarm(UParticleSystem* Template, int32 Count = -1);
+
+	/** Override the maximum number of components for a template */
+	void SetTemplateCap(UParticleSystem* Template, int32 Cap);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FParticlePool& FindOrAddPool(UParticleSystem* Template);
+
+	UParticleSystemComponent* CreateComponent(UParticleSystem* Template);
+
+	/** Bound to each pooled component, puts it back to the free list */
+	UFUNCTION()
+	void OnParticleSystemFinished(UParticleSystemComponent* Component);
+
+	UPROPERTY()
+	TMap<UParticleSystem*, FParticlePool> Pools;
+
+	/** Maximum number of components per template, once reached the oldest playing one gets recycled */
+	UPROPERTY(Config)
+	int32 DefaultMaxComponentsPerTemplate{ 32 };
+
+	/** Number of components Prewarm creates when no count is given */
+	UPROPERTY(Config)
+	int32 DefaultPrewarmCount{ 8 };
+};
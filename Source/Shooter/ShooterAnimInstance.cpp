@@ -37,55 +37,93 @@ UShooterAnimInstance::UShooterAnimInstance():
 	
 {}
 
+namespace ShooterAnimCurves
+{
+	/** Curve names resolved once instead of building an FName from a string every frame */
+	static const FName Turning(TEXT("Turning"));
+	static const FName Rotation(TEXT("Rotation"));
+}
+
 void UShooterAnimInstance::UpdateAnimation(float DeltaTime)
 {
+	// Nothing left to do here, see NativeUpdateAnimation and NativeThreadSafeUpdateAnimation
+}
+
+void UShooterAnimInstance::NativeInitializeAnimation()
+{
+	ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
+}
+
+void UShooterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeUpdateAnimation(DeltaSeconds);
+
 	if(ShooterCharacter == nullptr)
 	{
 		ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
 	}
+	TakeSnapshot();
+}
+
+void UShooterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
 
 	// Update properties
 	UpdateAnimationProperties();
 
 	// Animation mechanics
 	Strafe();
-	TurnInPlace(DeltaTime);
-	Lean(DeltaTime);
+	TurnInPlace(DeltaSeconds);
+	Lean(DeltaSeconds);
 }
 
-void UShooterAnimInstance::NativeInitializeAnimation()
+void UShooterAnimInstance::TakeSnapshot()
 {
-	ShooterCharacter = Cast<AShooterCharacter>(TryGetPawnOwner());
+	Snapshot.bValid = ShooterCharacter != nullptr;
+	if(!Snapshot.bValid) return;
+
+	const ECombatState CombatState{ ShooterCharacter -> GetCombatState() };
+	const UCharacterMovementComponent* Movement{ ShooterCharacter -> GetCharacterMovement() };
+	Snapshot.Speed = ShooterCharacter -> GetCurrentSpeed();
+	Snapshot.bAiming = ShooterCharacter -> GetAiming();
+	Snapshot.bFiring = ShooterCharacter -> GetFireButtonPressed();
+	Snapshot.bCrouching = ShooterCharacter -> GetCrouching();
+	Snapshot.bReloading = CombatState == ECombatState::ECS_Reloading;
+	Snapshot.bEquipping = CombatState == ECombatState::ECS_Equipping;
+	Snapshot.bUnoccupied = CombatState == ECombatState::ECS_Unoccupied;
+	Snapshot.bShouldUseFABRIK = CombatState == ECombatState::ECS_Unoccupied ||
+		CombatState == ECombatState::ECS_FireRateTimerInProgress;
+	Snapshot.bIsInAir = Movement -> IsFalling();
+	Snapshot.bIsAccelerating = Movement -> GetCurrentAcceleration().Size() > 0.f;
+	Snapshot.bHasEquippedWeapon = ShooterCharacter -> GetEquippedWeapon() != nullptr;
+	if(Snapshot.bHasEquippedWeapon)
+		Snapshot.EquippedWeaponType = ShooterCharacter -> GetEquippedWeapon() -> GetWeaponType();
+	Snapshot.AimRotation = ShooterCharacter -> GetBaseAimRotation();
+	Snapshot.ActorRotation = ShooterCharacter -> GetActorRotation();
+	Snapshot.Velocity = ShooterCharacter -> GetVelocity();
 }
 
 void UShooterAnimInstance::UpdateAnimationProperties()
 {
-	if(ShooterCharacter == nullptr) return;
-
-	// Get properties from character class
-	Speed = ShooterCharacter -> GetCurrentSpeed();
-	bAiming = ShooterCharacter -> GetAiming();
-	bFiring = ShooterCharacter -> GetFireButtonPressed();
-	bCrouching = ShooterCharacter -> GetCrouching();
-	bReloading = ShooterCharacter -> GetCombatState() == ECombatState::ECS_Reloading;
-	bEquipping = ShooterCharacter -> GetCombatState() == ECombatState::ECS_Equipping;
-	bIsInAir = ShooterCharacter -> GetCharacterMovement() -> IsFalling();
-	bShouldUseFABRIK = ShooterCharacter -> GetCombatState() == ECombatState::ECS_Unoccupied ||
-		ShooterCharacter -> GetCombatState() == ECombatState::ECS_FireRateTimerInProgress;
+	if(!Snapshot.bValid) return;
+
+	// Get properties from the character snapshot
+	Speed = Snapshot.Speed;
+	bAiming = Snapshot.bAiming;
+	bFiring = Snapshot.bFiring;
+	bCrouching = Snapshot.bCrouching;
+	bReloading = Snapshot.bReloading;
+	bEquipping = Snapshot.bEquipping;
+	bIsInAir = Snapshot.bIsInAir;
+	bShouldUseFABRIK = Snapshot.bShouldUseFABRIK;
 	
 	// Is the character accelerating?
-	if(ShooterCharacter -> GetCharacterMovement() -> GetCurrentAcceleration().Size() > 0.f)
-	{
-		bIsAccelerating = true;
-	}
-	else
-	{
-		bIsAccelerating = false;
-	}
+	bIsAccelerating = Snapshot.bIsAccelerating;
 
 	// EquippedWeaponType
-	if(ShooterCharacter -> GetEquippedWeapon())
-		EquippedWeaponType = ShooterCharacter -> GetEquippedWeapon() -> GetWeaponType();
+	if(Snapshot.bHasEquippedWeapon)
+		EquippedWeaponType = Snapshot.EquippedWeaponType;
 
 	// OffsetState
 	if(bIsInAir) OffsetState = EOffsetState::EOS_InAir;
@@ -107,7 +145,7 @@ void UShooterAnimInstance::UpdateIsIdle()
 	else if(bEquipping) bIsIdle = false;
 	else if(bTurning) bIsIdle = false;
 	else if(bCrouching) bIsIdle = false;
-	else if(ShooterCharacter -> GetCombatState() != ECombatState::ECS_Unoccupied) bIsIdle = false;
+	else if(!Snapshot.bUnoccupied) bIsIdle = false;
 	else bIsIdle = true;
 }
 
@@ -134,14 +172,14 @@ void UShooterAnimInstance::UpdateRecoilWeight()
 
 void UShooterAnimInstance::Strafe()
 {
-	if(ShooterCharacter == nullptr) return;
+	if(!Snapshot.bValid) return;
 
 	// Calculating MovementOffsetYaw for strafing
-	FRotator AimRotation = ShooterCharacter -> GetBaseAimRotation();
-	FRotator MovementRotation = UKismetMathLibrary::MakeRotFromX(ShooterCharacter -> GetVelocity());
+	FRotator AimRotation = Snapshot.AimRotation;
+	FRotator MovementRotation = UKismetMathLibrary::MakeRotFromX(Snapshot.Velocity);
 	MovementOffsetYaw = UKismetMathLibrary::NormalizedDeltaRotator(MovementRotation, AimRotation).Yaw;
 
-	if(ShooterCharacter -> GetVelocity().Size() > 0.f)
+	if(Snapshot.Velocity.Size() > 0.f)
 	{
 		LastMovementOffsetYaw = MovementOffsetYaw;
 	}
@@ -149,7 +187,7 @@ void UShooterAnimInstance::Strafe()
 
 void UShooterAnimInstance::TurnInPlace(float DeltaTime)
 {
-	if(ShooterCharacter == nullptr) return;
+	if(!Snapshot.bValid) return;
 	if(Speed > 0 || bIsInAir)
 	{
 		// We don't want to turn in place when we are moving or floating in air;
@@ -158,10 +196,10 @@ void UShooterAnimInstance::TurnInPlace(float DeltaTime)
 		// Interp between standing yaw and walking forward yaw value
 		RootYawOffset = FMath::FInterpTo(RootYawOffset, 0.f, DeltaTime,
 			FMath::Abs(RootYawOffset) > 40 ? JogTurningInterpSpeed - 12.f : JogTurningInterpSpeed);
-		const float TargetPitch = ShooterCharacter -> GetBaseAimRotation().Pitch; // Target for hand pitch to follow
+		const float TargetPitch = Snapshot.AimRotation.Pitch; // Target for hand pitch to follow
 		// To give character's holding hand a realistic feeling of holding a gun while jogging
 		CharacterCurrentPitch = FMath::FInterpTo(CharacterCurrentPitch, TargetPitch, DeltaTime, JogTurningInterpSpeed);
-		TIPCharacterYaw = ShooterCharacter -> GetActorRotation().Yaw;
+		TIPCharacterYaw = Snapshot.ActorRotation.Yaw;
 		TIPCharacterYawPreviousFrame = TIPCharacterYaw;
 		RotationCurvePreviousFrame = 0.f;
 		RotationCurve = 0.f;
@@ -169,22 +207,22 @@ void UShooterAnimInstance::TurnInPlace(float DeltaTime)
 	else
 	{	
 		// Getting the pitch of controller(Cursor)
-		CharacterCurrentPitch = ShooterCharacter -> GetBaseAimRotation().Pitch;
+		CharacterCurrentPitch = Snapshot.AimRotation.Pitch;
 		
 		TIPCharacterYawPreviousFrame = TIPCharacterYaw;
-		TIPCharacterYaw = ShooterCharacter -> GetActorRotation().Yaw;
+		TIPCharacterYaw = Snapshot.ActorRotation.Yaw;
 		const float TIPCharacterYawDelta{ TIPCharacterYaw - TIPCharacterYawPreviousFrame };
 
 		// Clamp RootYawOffset between [-180, 180]
 		RootYawOffset = UKismetMathLibrary::NormalizeAxis( RootYawOffset - TIPCharacterYawDelta );
 
 		// 1.0 if turning, 0.0 if not
-		const float Turning{ GetCurveValue(TEXT("Turning")) };
+		const float Turning{ GetCurveValue(ShooterAnimCurves::Turning) };
 		if(Turning > 0)
 		{
 			bTurning = true;
 			RotationCurvePreviousFrame = RotationCurve;
-			RotationCurve = GetCurveValue(TEXT("Rotation"));
+			RotationCurve = GetCurveValue(ShooterAnimCurves::Rotation);
 			const float DeltaRotation{ RotationCurve - RotationCurvePreviousFrame };
 			
 			// RootYawOffset > 0, -> Turning left; RootYawOffset < 0, -> Turning right.
@@ -209,7 +247,7 @@ void UShooterAnimInstance::TurnInPlace(float DeltaTime)
 
 void UShooterAnimInstance::Lean(float DeltaTime)
 {
-	if(ShooterCharacter == nullptr) return;
+	if(!Snapshot.bValid) return;
 	if(Speed == 0) // if not moving
 	{
 		// Zero out CharacterYawDelta smoothly
@@ -218,7 +256,7 @@ void UShooterAnimInstance::Lean(float DeltaTime)
 	}
 
 	CharacterRotationPreviousFrame = CharacterRotation;
-	CharacterRotation = ShooterCharacter -> GetActorRotation();
+	CharacterRotation = Snapshot.ActorRotation;
 
 	const FRotator RotationDelta = UKismetMathLibrary::NormalizedDeltaRotator
 	(CharacterRotation, CharacterRotationPreviousFrame);
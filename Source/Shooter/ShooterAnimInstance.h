@@ -18,6 +18,27 @@ enum class EOffsetState : uint8
 	EOS_Max UMETA(DisplayName = "DefaultMax")
 };
 
+/** Character state copied on the game thread, so the animation math can run on a worker thread */
+struct FShooterAnimSnapshot
+{
+	bool bValid{ false };
+	float Speed{ 0.f };
+	bool bAiming{ false };
+	bool bFiring{ false };
+	bool bCrouching{ false };
+	bool bReloading{ false };
+	bool bEquipping{ false };
+	bool bUnoccupied{ true };
+	bool bShouldUseFABRIK{ false };
+	bool bIsInAir{ false };
+	bool bIsAccelerating{ false };
+	bool bHasEquippedWeapon{ false };
+	EWeaponType EquippedWeaponType{ EWeaponType::EWT_DefaultMax };
+	FRotator AimRotation{ FRotator::ZeroRotator };
+	FRotator ActorRotation{ FRotator::ZeroRotator };
+	FVector Velocity{ FVector::ZeroVector };
+};
+
 UCLASS()
 class SHOOTER_API UShooterAnimInstance : public UAnimInstance
 {
@@ -26,15 +47,25 @@ public:
 
 	UShooterAnimInstance();
 	
-	UFUNCTION(BlueprintCallable)
+	/** Kept so existing event graphs still compile, the update runs natively on a worker thread now */
+	UFUNCTION(BlueprintCallable, meta = (DeprecatedFunction, DeprecationMessage = "Updated natively in NativeThreadSafeUpdateAnimation, remove the call"))
 	void UpdateAnimation(float DeltaTime);
 
     virtual void NativeInitializeAnimation() override;
+
+	/** Copy the character state into the snapshot, on the game thread */
+	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+
+	/** Run the animation math from the snapshot, on a worker thread */
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 protected:
 
 	/** Update properties, such as Speed, bAiming, bFiring... (ect) */
 	void UpdateAnimationProperties();
 
+	/** Read the character, game thread only */
+	void TakeSnapshot();
+
 	void UpdateIsIdle();
 	void UpdateRecoilWeight();
 	
@@ -51,6 +82,9 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
 	class AShooterCharacter* ShooterCharacter;
 
+	/** State of ShooterCharacter this frame, the only character data the worker thread reads */
+	FShooterAnimSnapshot Snapshot;
+
 	/** The Speed of the character */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
 	float Speed;
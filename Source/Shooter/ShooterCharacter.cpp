@@ -2,13 +2,21 @@
 
 #include "ShooterCharacter.h"
 
+#include "Shooter.h"
 #include "Ammo.h"
 #include "BulletHitInterface.h"
+#include "CombatDamageSubsystem.h"
+#include "CombatSnapshotSubsystem.h"
 #include "Enemy.h"
 #include "EnemyController.h"
+#include "HitNumberManager.h"
+#include "HitscanSubsystem.h"
+#include "InventoryComponent.h"
 #include "Item.h"
+#include "ItemPoolSubsystem.h"
+#include "ItemRegistrySubsystem.h"
+#include "ParticlePoolSubsystem.h"
 #include "Weapon.h"
-#include "BehaviorTree/BlackboardComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Components/WidgetComponent.h"
@@ -19,6 +27,9 @@
 #include "Engine/SkeletalMeshSocket.h"
 #include "Particles/ParticleSystemComponent.h"
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crosshair Traces"), STAT_CrosshairTraces, STATGROUP_Shooter);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crosshair Traces Saved"), STAT_CrosshairTracesSaved, STATGROUP_Shooter);
+
 // Sets default values
 AShooterCharacter::AShooterCharacter():
 	// Properties
@@ -58,11 +69,15 @@ AShooterCharacter::AShooterCharacter():
 	bAimingButtonPressed(false),
 	bFireButtonPressed(false),
 	bShouldFire(true),
+	FireCooldown(0.f),
+	FireCooldownStartFrame(0),
+	MaxShotsPerFrame(8),
+	LastMuzzleSampleTime(0.f),
+	LastMuzzleSampleFrame(0),
 	bFiringBullet(false),
 	CrosshairShootingDuration(0.05f),
 	// Item trace variables
-	bShouldTraceForItems(false),
-	OverlappedItemCount(0),
+	PickupConeHalfAngle(10.f),
 	// Starting ammo amounts
 	Starting9mmAmmo(80),
 	StartingARAmmo(120),
@@ -87,9 +102,7 @@ AShooterCharacter::AShooterCharacter():
 	bShouldPlayPickupSound(true),
 	bShouldPlayEquipSound(true),
 	PickupSoundTimerDuration(0.2f),
-	EquipSoundTimerDuration(0.2f),
-	// Inventory properties
-	HighlightedSlotIndex(-1)
+	EquipSoundTimerDuration(0.2f)
 {
 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
@@ -137,6 +150,8 @@ AShooterCharacter::AShooterCharacter():
 	InterpComp5 -> SetupAttachment(GetFollowCamera());
 	InterpComp6 = CreateDefaultSubobject<USceneComponent>(TEXT("Interpolation Component 6"));
 	InterpComp6 -> SetupAttachment(GetFollowCamera());
+
+	InventoryComponent = CreateDefaultSubobject<UInventoryComponent>(TEXT("InventoryComponent"));
 	
 }
 
@@ -150,7 +165,7 @@ float AShooterCharacter::TakeDamage(float DamageAmount, FDamageEvent const& Dama
 		auto EnemyController = Cast<AEnemyController>(EventInstigator);
 		if(EnemyController)
 		{
-			EnemyController -> GetBlackboardComponent() -> SetValueAsBool("TargetIsDead", true);
+			EnemyController -> SetBlackboardBool(EEnemyBlackboardKey::TargetIsDead, true);
 		}
 	}
 	else
@@ -160,6 +175,15 @@ float AShooterCharacter::TakeDamage(float DamageAmount, FDamageEvent const& Dama
 	return DamageAmount;
 }
 
+void AShooterCharacter::HitReact_Implementation(int32 HitCount)
+{
+	const float Chance{ FMath::FRandRange(0.f, 1.f) };
+	if(Chance <= StunChance)
+	{
+		Stun();
+	}
+}
+
 void AShooterCharacter::BeginPlay()
 {
 	Super::BeginPlay();
@@ -169,14 +193,26 @@ void AShooterCharacter::BeginPlay()
 		CameraDefaultFOV = GetFollowCamera() -> FieldOfView;
 		CameraCurrentFOV = CameraDefaultFOV;
 	}
+	// Widgets bound to the character keep receiving the Inventory events
+	InventoryComponent -> GetEquipItemDelegate().AddDynamic(this, &AShooterCharacter::ForwardEquipItem);
+	InventoryComponent -> GetHighlightIconDelegate().AddDynamic(this, &AShooterCharacter::ForwardHighlightIcon);
+	InventoryComponent -> GetSlotChangedDelegate().AddUObject(this, &AShooterCharacter::MirrorInventorySlot);
+	InventoryComponent -> GetAmmoChangedDelegate().AddUObject(this, &AShooterCharacter::MirrorInventoryAmmo);
 	// Spawn the default Weapon and equip it
-	AddToInventory(SpawnDefaultWeapon());
-	EquipWeapon(Cast<AWeapon>(Inventory[0]));
+	const int32 DefaultWeaponSlot{ InventoryComponent -> AddItem(SpawnDefaultWeapon()) };
+	EquipWeapon(Cast<AWeapon>(InventoryComponent -> GetItem(DefaultWeaponSlot)));
 	EquippedWeapon -> SetCharacter(this);
-	// Initialize AmmoMap with starting values
-	InitializeAmmoMap();
+	// Give the inventory its starting ammo
+	InitializeAmmo();
 	// Initialize InterpLocations for item picking interping
 	InitializeInterpLocations();
+	// Warm up the particle pools used on every shot
+	if(UParticlePoolSubsystem* ParticlePool = GetWorld() -> GetSubsystem<UParticlePoolSubsystem>())
+	{
+		ParticlePool -> Prewarm(BulletImpactParticles);
+		ParticlePool -> Prewarm(BeamParticles);
+		ParticlePool -> Prewarm(BloodParticles);
+	}
 }
 
 void AShooterCharacter::UpdateProperties()
@@ -244,66 +280,106 @@ void AShooterCharacter::FireWeapon()
 
 	if(WeaponHasAmmo())
 	{
-		// Visuals
-		PlayFireSound();
-		SendBullet();
-		PlayHipFireMontage();
+		const float ShotTime{ GetWorld() -> GetTimeSeconds() };
+		FireShots(MakeArrayView(&ShotTime, 1));
 		
-		// Decrement ammo
+		// Start the cooldown to kill off weapon, in order to simulate its fire rate
+		StartFireCooldown();
+	}
+}
+
+void AShooterCharacter::FireShots(TArrayView<const float> ShotTimes)
+{
+	if(EquippedWeapon == nullptr || ShotTimes.Num() == 0) return;
+
+	// Visuals, once for the whole batch
+	PlayFireSound();
+	SendBullets(ShotTimes);
+	PlayHipFireMontage();
+	
+	// Decrement ammo
+	for(int32 i = 0; i < ShotTimes.Num(); i++)
+	{
 		EquippedWeapon -> DecrementAmmo();
+	}
 
-		// Start bullet fire timer for crosshairs
-		StartCrosshairBulletFire();
-		
-		// Start FireRateTimer to kill off weapon, in order to simulate its fire rate
-		StartFireRateTimer();
+	// Start bullet fire timer for crosshairs
+	StartCrosshairBulletFire();
 
-		if(EquippedWeapon -> GetWeaponType() == EWeaponType::EWT_Pistol)
-		{
-			EquippedWeapon -> StartSlideTimer();
-		}
+	if(EquippedWeapon -> GetWeaponType() == EWeaponType::EWT_Pistol)
+	{
+		EquippedWeapon -> StartSlideTimer();
 	}
 }
 
 bool AShooterCharacter::LineTraceFromCrosshair(FHitResult &OutHitResult) const
 {
-	// Get current size of the viewport
-	FVector2D ViewportSize;
-	if(GEngine && GEngine -> GameViewport)
+	APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+	if(PlayerController == nullptr) return false;
+
+	// Reuse the trace made earlier this frame, as long as the camera hasn't moved since
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController -> GetPlayerViewPoint(ViewLocation, ViewRotation);
+	if(CrosshairTraceCache.IsValidFor(GFrameCounter, ViewLocation, ViewRotation))
 	{
-		GEngine -> GameViewport -> GetViewportSize(ViewportSize);
+		INC_DWORD_STAT(STAT_CrosshairTracesSaved);
+		OutHitResult = CrosshairTraceCache.HitResult;
+		return CrosshairTraceCache.bBlockingHit;
 	}
 
-	// Get screen space location of crosshair
-	FVector2D CrosshairLocation(ViewportSize.X / 2.f, ViewportSize.Y / 2.f);
-	CrosshairLocation.Y -= 50.f;
 	FVector CrosshairWorldPosition;
 	FVector CrosshairWorldDirection;
-
-	// Get world position and direction of crosshair
-	const bool bScreenToWorld = UGameplayStatics::DeprojectScreenToWorld
-	(UGameplayStatics::GetPlayerController(this, 0),
-	 CrosshairLocation, CrosshairWorldPosition, CrosshairWorldDirection);
-
-	if(!bScreenToWorld) return false; // Was deprojection successful?
+	if(!GetCrosshairRay(CrosshairWorldPosition, CrosshairWorldDirection)) return false;
 
 	const FVector Start{ CrosshairWorldPosition };
 	const FVector End{ CrosshairWorldPosition + CrosshairWorldDirection * 50'000.f };
 
 	// Trace outward from crosshairs world location
+	INC_DWORD_STAT(STAT_CrosshairTraces);
 	GetWorld() -> LineTraceSingleByChannel(OutHitResult, Start, End, ECollisionChannel::ECC_Visibility);
 	
-	if(OutHitResult.bBlockingHit) return true;
+	if(!OutHitResult.bBlockingHit)
+	{
+		OutHitResult.Location = End; // Mutating location
+	}
+
+	// Cache the result for the rest of this frame
+	CrosshairTraceCache.FrameNumber = GFrameCounter;
+	CrosshairTraceCache.ViewLocation = ViewLocation;
+	CrosshairTraceCache.ViewRotation = ViewRotation;
+	CrosshairTraceCache.HitResult = OutHitResult;
+	CrosshairTraceCache.bBlockingHit = OutHitResult.bBlockingHit;
 	
-	OutHitResult.Location = End; // Mutating location
-	return false;
+	return OutHitResult.bBlockingHit;
 }
 
-bool AShooterCharacter::LineTraceFromGunBarrel(const FVector& MuzzleSocketLocation, FHitResult& OutHitResult) const
+bool AShooterCharacter::GetCrosshairRay(FVector& OutStart, FVector& OutDirection) const
+{
+	APlayerController* PlayerController = UGameplayStatics::GetPlayerController(this, 0);
+	if(PlayerController == nullptr) return false;
+
+	// Get current size of the viewport
+	FVector2D ViewportSize;
+	if(GEngine && GEngine -> GameViewport)
+	{
+		GEngine -> GameViewport -> GetViewportSize(ViewportSize);
+	}
+
+	// Get screen space location of crosshair
+	FVector2D CrosshairLocation(ViewportSize.X / 2.f, ViewportSize.Y / 2.f);
+	CrosshairLocation.Y -= 50.f;
+
+	// Get world position and direction of crosshair
+	return UGameplayStatics::DeprojectScreenToWorld(PlayerController, CrosshairLocation, OutStart, OutDirection);
+}
+
+void AShooterCharacter::GetGunBarrelTrace(const FVector& MuzzleSocketLocation, FVector& OutTraceEnd,
+	FVector& OutBeamLocation) const
 {
 	FHitResult CrosshairHitResult;
 	LineTraceFromCrosshair(CrosshairHitResult);
-	FVector OutBeamLocation = CrosshairHitResult.Location;
+	OutBeamLocation = CrosshairHitResult.Location;
 	
 	/* If Crosshair's lineTrace hit something, OutBeamLocation will be set to
 	 * the location of the hit,
@@ -311,19 +387,9 @@ bool AShooterCharacter::LineTraceFromGunBarrel(const FVector& MuzzleSocketLocati
 	 * However we still need another trace from the gun barrel:
 	 */
 
-	// Performs a second line trace, this time from the gun barrel
-	const FVector WeaponTraceStart{ MuzzleSocketLocation };
+	// The second line trace goes from the gun barrel, slightly past the BeamEnd
 	const FVector StartToEnd{ OutBeamLocation - MuzzleSocketLocation };
-	const FVector WeaponTraceEnd{ MuzzleSocketLocation + StartToEnd * 1.25 };
-
-	GetWorld() -> LineTraceSingleByChannel(OutHitResult, WeaponTraceStart, WeaponTraceEnd,
-	                                     ECollisionChannel::ECC_Visibility);
-	if(!OutHitResult.bBlockingHit) // Is there something between the barrel and the BeamEnd?
-	{
-		OutHitResult.Location = OutBeamLocation;
-		return false;
-	}
-	return true;
+	OutTraceEnd = MuzzleSocketLocation + StartToEnd * 1.25;
 }
 
 void AShooterCharacter::FireButtonPressed()
@@ -482,27 +548,60 @@ void AShooterCharacter::FinishCrosshairBulletFire()
 	bFiringBullet = false;
 }
 
-void AShooterCharacter::StartFireRateTimer()
+void AShooterCharacter::StartFireCooldown()
 {
 	if(EquippedWeapon == nullptr) return;
 	CombatState = ECombatState::ECS_FireRateTimerInProgress;
-	GetWorldTimerManager().SetTimer(AutomaticFireRateTimer, this, &AShooterCharacter::FireRateTimerReset,
-		EquippedWeapon -> GetAutoFireRate());
+	FireCooldown = EquippedWeapon -> GetAutoFireRate();
+	FireCooldownStartFrame = GFrameCounter;
 }
 
-void AShooterCharacter::FireRateTimerReset()
+void AShooterCharacter::UpdateFireScheduler(float DeltaTime)
 {
-	if(EquippedWeapon == nullptr || CombatState == ECombatState::ECS_Stunned) return;
-	CombatState = ECombatState::ECS_Unoccupied;
+	if(CombatState != ECombatState::ECS_FireRateTimerInProgress) return;
+	if(EquippedWeapon == nullptr)
+	{
+		CombatState = ECombatState::ECS_Unoccupied;
+		return;
+	}
+	// The shot which started the cooldown was fired this frame
+	if(FireCooldownStartFrame == GFrameCounter) return;
 
-	if(WeaponHasAmmo())
+	FireCooldown -= DeltaTime;
+	if(FireCooldown > 0.f)
 	{
-		if(bFireButtonPressed && EquippedWeapon -> GetAutomatic())
+		SampleMuzzleTransform();
+		return;
+	}
+
+	const float FireInterval{ EquippedWeapon -> GetAutoFireRate() };
+	const float CurrentTime{ GetWorld() -> GetTimeSeconds() };
+	int32 AmmoLeft{ EquippedWeapon -> GetAmmo() };
+	TArray<float, TInlineAllocator<8>> ShotTimes;
+
+	// Every time the cooldown runs out another shot is due. FireCooldown is the negative
+	// amount of time the shot is overdue, which gives its timestamp within this frame.
+	while(FireCooldown <= 0.f)
+	{
+		if(AmmoLeft <= 0 || !bFireButtonPressed || !EquippedWeapon -> GetAutomatic())
+		{
+			CombatState = ECombatState::ECS_Unoccupied;
+			break;
+		}
+		if(ShotTimes.Num() >= MaxShotsPerFrame)
 		{
-			FireWeapon();
+			// Drop what's left of a long hitch instead of firing it all at once
+			FireCooldown = 0.f;
+			break;
 		}
+		ShotTimes.Add(CurrentTime + FireCooldown);
+		FireCooldown += FireInterval;
+		AmmoLeft--;
 	}
-	else // Weapon is empty
+
+	FireShots(ShotTimes);
+
+	if(CombatState == ECombatState::ECS_Unoccupied && !WeaponHasAmmo()) // Weapon is empty
 	{
 		ReloadWeapon();
 	}
@@ -510,78 +609,74 @@ void AShooterCharacter::FireRateTimerReset()
 
 void AShooterCharacter::PickupTrace()
 {
-	if(bShouldTraceForItems)
+	PickupTraceHitItem = FindPickupItem();
+
+	const auto PickupTraceHitWeapon = Cast<AWeapon>(PickupTraceHitItem);
+	if(PickupTraceHitWeapon)
 	{
-		FHitResult ItemTraceResult;
-		LineTraceFromCrosshair(ItemTraceResult);
-		
-		if(ItemTraceResult.bBlockingHit)
+		if(InventoryComponent -> GetHighlightedSlotIndex() == -1)
 		{
-			PickupTraceHitItem = Cast<AItem>(ItemTraceResult.GetActor());
-			if(PickupTraceHitItem && PickupTraceHitItem -> GetItemState() == EItemState::EIS_EquipInterp)
-			{
-				PickupTraceHitItem = nullptr;
-			}
-
-			const auto PickupTraceHitWeapon = Cast<AWeapon>(PickupTraceHitItem);
-			if(PickupTraceHitWeapon)
-			{
-				if(HighlightedSlotIndex == -1)
-				{
-					HighlightInventorySlot();
-				}
-			}
-			else
-			{
-				if(HighlightedSlotIndex != -1)
-				{
-					UnHighlightInventorySlot();
-				}
-			}
-			
-			if(PickupTraceHitItem && PickupTraceHitItem -> GetPickupWidget())
-			{
-				// Show Item pickup widget 
-				PickupTraceHitItem -> GetPickupWidget() -> SetVisibility(true);
-				PickupTraceHitItem -> EnableCustomDepth();
-
-				if(Inventory.Num() >= INVENTORY_CAPACITY)
-				{
-					PickupTraceHitItem -> SetCharacterInventoryFull(true);
-				}
-				else // Inventory has room
-				{
-					PickupTraceHitItem -> SetCharacterInventoryFull(false);
-				}
-			}
-
-			// If linetrace hit an item last frame
-			if(PreviousPickupTraceHitItem && PreviousPickupTraceHitItem -> GetPickupWidget())
-			{
-				if(PickupTraceHitItem != PreviousPickupTraceHitItem) // If linetrace hit a new item this frame
-				{
-					PreviousPickupTraceHitItem -> GetPickupWidget() -> SetVisibility(false);
-					PreviousPickupTraceHitItem -> DisableCustomDepth();
-				}
-			}
-			
-			// Saving a reference to the item linetrace hit, last frame. or either null ptr.
-			PreviousPickupTraceHitItem = PickupTraceHitItem;
+			HighlightInventorySlot();
 		}
 	}
-	else if(PreviousPickupTraceHitItem) // If character no longer overlap items, and the last item isn't null.
+	else
 	{
-		PreviousPickupTraceHitItem -> GetPickupWidget() -> SetVisibility(false);
-		PreviousPickupTraceHitItem -> DisableCustomDepth();
+		if(InventoryComponent -> GetHighlightedSlotIndex() != -1)
+		{
+			UnHighlightInventorySlot();
+		}
 	}
+	
+	if(PickupTraceHitItem && PickupTraceHitItem -> GetPickupWidget())
+	{
+		// Show Item pickup widget 
+		PickupTraceHitItem -> GetPickupWidget() -> SetVisibility(true);
+		PickupTraceHitItem -> EnableCustomDepth();
+
+		PickupTraceHitItem -> SetCharacterInventoryFull(InventoryComponent -> IsFull());
+	}
+
+	// If we aimed at another item last frame, or at nothing anymore
+	if(PreviousPickupTraceHitItem && PreviousPickupTraceHitItem -> GetPickupWidget())
+	{
+		if(PickupTraceHitItem != PreviousPickupTraceHitItem)
+		{
+			PreviousPickupTraceHitItem -> GetPickupWidget() -> SetVisibility(false);
+			PreviousPickupTraceHitItem -> DisableCustomDepth();
+		}
+	}
+	
+	// Saving a reference to the item we aimed at this frame, or either null ptr.
+	PreviousPickupTraceHitItem = PickupTraceHitItem;
+}
+
+AItem* AShooterCharacter::FindPickupItem() const
+{
+	const UItemRegistrySubsystem* ItemRegistry = GetWorld() -> GetSubsystem<UItemRegistrySubsystem>();
+	if(ItemRegistry == nullptr) return nullptr;
+
+	FVector CrosshairWorldPosition;
+	FVector CrosshairWorldDirection;
+	if(!GetCrosshairRay(CrosshairWorldPosition, CrosshairWorldDirection)) return nullptr;
+
+	const float MinViewDot{ FMath::Cos(FMath::DegreesToRadians(PickupConeHalfAngle)) };
+	return ItemRegistry -> FindBestItemInView(GetActorLocation(), GetCapsuleComponent() -> GetScaledCapsuleRadius(),
+		CrosshairWorldPosition, CrosshairWorldDirection, MinViewDot, this);
 }
 
 AWeapon* AShooterCharacter::SpawnDefaultWeapon() const
 {
 	if(DefaultWeaponClass)
 	{
-		const auto Actor = GetWorld() -> SpawnActor<AWeapon>(DefaultWeaponClass);
-		Actor -> DisableGlowMaterial();
+		UItemPoolSubsystem* ItemPool = GetWorld() -> GetSubsystem<UItemPoolSubsystem>();
+		const auto Actor = ItemPool ? ItemPool -> AcquireItem<AWeapon>(DefaultWeaponClass, FTransform::Identity)
+			: GetWorld() -> SpawnActor<AWeapon>(DefaultWeaponClass);
+		if(Actor)
+		{
+			// Equipped this frame, can't wait for the stream to give it a mesh and a BarrelSocket
+			Actor -> LoadWeaponAssetsNow();
+			Actor -> DisableGlowMaterial();
+		}
 		return Actor;
 	}
 	return nullptr;
@@ -599,13 +694,12 @@ void AShooterCharacter::EquipWeapon(AWeapon* WeaponToEquip,  bool bSwapping)
 		if(EquippedWeapon == nullptr) // Broadcasting Inventory selection index
 		{
 			// -1 == Spawned default weapon. no need to reverse any icon animation.
-			EquipItemDelegate.Broadcast(-1, WeaponToEquip -> GetSlotIndex());
+			InventoryComponent -> BroadcastEquipItem(-1, WeaponToEquip -> GetSlotIndex());
 		}
 		else if(!bSwapping) // if we are swapping, we don't need to reverse the animation.
 		{
 			// Reverse the previously equipped item anim icon, and forward play the newly equipped item anim icon
-			EquipItemDelegate.Broadcast(EquippedWeapon -> GetSlotIndex(),
-				WeaponToEquip -> GetSlotIndex());
+			InventoryComponent -> BroadcastEquipItem(EquippedWeapon -> GetSlotIndex(), WeaponToEquip -> GetSlotIndex());
 		}
 		EquippedWeapon = WeaponToEquip;
 		EquippedWeapon -> SetItemState(EItemState::EIS_Equipped);
@@ -628,29 +722,15 @@ void AShooterCharacter::SwapWeapon(AWeapon* WeaponToSwap)
 {
 	if(EquippedWeapon == nullptr || WeaponToSwap == nullptr) return;
 	
-	ReplaceInInventory(WeaponToSwap, EquippedWeapon -> GetSlotIndex());
+	InventoryComponent -> SetItem(EquippedWeapon -> GetSlotIndex(), WeaponToSwap);
 	DropWeapon();
 	EquipWeapon(WeaponToSwap, true);
 }
 
-void AShooterCharacter::AddToInventory(AWeapon* Weapon)
-{
-	Inventory.Add(Weapon); // Add it at the end of the inventory list
-	Weapon -> SetSlotIndex(Inventory.Find(Weapon)); // Indicate and save index location for the Weapon class
-}
-
-void AShooterCharacter::ReplaceInInventory(AWeapon* Weapon, int32 Index)
-{
-	if(Inventory.IsValidIndex(Index)) // If the index we are replacing exists in the inventory
-	{
-		Inventory[Index] = Weapon; // Replace it at a specific index in the inventory list
-		Weapon -> SetSlotIndex(Index); // Update the index
-	}
-}
-
 void AShooterCharacter::ExchangeInventoryItems(int32 CurrentItemIndex, int32 NewItemIndex)
 {
-	const bool bCanExchangeItems = (CurrentItemIndex != NewItemIndex) && (Inventory.IsValidIndex(NewItemIndex))
+	AWeapon* NewWeapon = Cast<AWeapon>(InventoryComponent -> GetItem(NewItemIndex));
+	const bool bCanExchangeItems = (CurrentItemIndex != NewItemIndex) && (NewWeapon != nullptr)
 	&& (CombatState == ECombatState::ECS_Unoccupied);
 
 	if(bCanExchangeItems)
@@ -660,7 +740,7 @@ void AShooterCharacter::ExchangeInventoryItems(int32 CurrentItemIndex, int32 New
 			StopAiming();
 		}
 		EquippedWeapon -> SetItemState(EItemState::EIS_PickedUp);
-		EquipWeapon(Cast<AWeapon>(Inventory[NewItemIndex]));
+		EquipWeapon(NewWeapon);
 
 		UAnimInstance* AnimInstance = GetMesh() -> GetAnimInstance();
 		if(AnimInstance && HipEquipMontage)
@@ -672,10 +752,10 @@ void AShooterCharacter::ExchangeInventoryItems(int32 CurrentItemIndex, int32 New
 	}
 }
 
-void AShooterCharacter::InitializeAmmoMap()
+void AShooterCharacter::InitializeAmmo()
 {
-	AmmoMap.Add(EAmmoType::EAT_9mm, Starting9mmAmmo);	
-	AmmoMap.Add(EAmmoType::EAT_AR, StartingARAmmo);	
+	InventoryComponent -> SetAmmo(EAmmoType::EAT_9mm, Starting9mmAmmo);
+	InventoryComponent -> SetAmmo(EAmmoType::EAT_AR, StartingARAmmo);
 }
 
 bool AShooterCharacter::WeaponHasAmmo() const
@@ -693,7 +773,7 @@ void AShooterCharacter::PlayFireSound() const
 	}
 }
 
-void AShooterCharacter::SendBullet() const
+void AShooterCharacter::SendBullets(TArrayView<const float> ShotTimes)
 {
 	if(EquippedWeapon == nullptr) return;
 	if(const USkeletalMeshSocket* BarrelSocket = EquippedWeapon -> GetItemMesh() -> GetSocketByName("BarrelSocket"))
@@ -701,63 +781,115 @@ void AShooterCharacter::SendBullet() const
 		const FTransform SocketTransform = BarrelSocket -> GetSocketTransform(EquippedWeapon -> GetItemMesh());
 		if(EquippedWeapon -> GetMuzzleFlash())
 		{
-			UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), EquippedWeapon -> GetMuzzleFlash(), SocketTransform);
+			UParticlePoolSubsystem::SpawnPooledEmitter(this, EquippedWeapon -> GetMuzzleFlash(), SocketTransform);
 		}
 
-		FHitResult BeamHitResult;
-		bool bBeamEnd = LineTraceFromGunBarrel(SocketTransform.GetLocation(), BeamHitResult);
-		if(bBeamEnd)
+		UHitscanSubsystem* HitscanSubsystem = GetWorld() -> GetSubsystem<UHitscanSubsystem>();
+		if(HitscanSubsystem == nullptr) return;
+
+		// Only a sample from last frame tells where the barrel was earlier in this one
+		const float CurrentTime{ GetWorld() -> GetTimeSeconds() };
+		const float SampleInterval{ CurrentTime - LastMuzzleSampleTime };
+		const bool bCanInterpolate{ LastMuzzleSampleFrame + 1 == GFrameCounter && SampleInterval > UE_SMALL_NUMBER };
+
+		// The barrel traces run asynchronously, ResolveBullet gets called with their results next frame
+		for(const float ShotTime : ShotTimes)
 		{
-			if(BeamHitResult.GetActor())
+			FTransform MuzzleTransform{ SocketTransform };
+			if(bCanInterpolate)
 			{
-				// Does hit actor implement BulletHitInterface?
-				IBulletHitInterface* BulletHitInterface = Cast<IBulletHitInterface>(BeamHitResult.GetActor());
-				if(BulletHitInterface)
-				{
-					BulletHitInterface -> BulletHit_Implementation(BeamHitResult);
-				}
-				
-				AEnemy* HitEnemy = Cast<AEnemy>(BeamHitResult.GetActor());
-				if(HitEnemy)
-				{
-					if(*BeamHitResult.BoneName.ToString() == HitEnemy -> GetHeadBone())
-					{ // Headshot
-						float Damage = UGameplayStatics::ApplyDamage(BeamHitResult.GetActor(),
-							EquippedWeapon -> GetHeadshotDamage(), GetController(), EquippedWeapon, UDamageType::StaticClass());
-						HitEnemy -> ShowHitNumber(Damage, BeamHitResult.Location, true);
-					}
-					else
-					{ // Bodyshot
-						float Damage = UGameplayStatics::ApplyDamage(BeamHitResult.GetActor(),
-							EquippedWeapon -> GetDamage(), GetController(), EquippedWeapon, UDamageType::StaticClass());
-						HitEnemy -> ShowHitNumber(Damage, BeamHitResult.Location, false);
-					}
-				}
-			}
-			else
-			{ // Spawn default particles
-				if(BulletImpactParticles)
-				{
-					UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), BulletImpactParticles, BeamHitResult.Location);
-				}
+				const float Alpha{ FMath::Clamp((ShotTime - LastMuzzleSampleTime) / SampleInterval, 0.f, 1.f) };
+				MuzzleTransform.Blend(LastMuzzleTransform, SocketTransform, Alpha);
 			}
+
+			// Every shot aims at the crosshair trace of this frame, made once and reused
+			FHitscanShot Shot;
+			GetGunBarrelTrace(MuzzleTransform.GetLocation(), Shot.TraceEnd, Shot.BeamEndLocation);
+			Shot.Shooter = this;
+			Shot.Weapon = EquippedWeapon;
+			Shot.Damage = EquippedWeapon -> GetDamage();
+			Shot.HeadshotDamage = EquippedWeapon -> GetHeadshotDamage();
+			Shot.MuzzleTransform = MuzzleTransform;
+			Shot.TraceStart = MuzzleTransform.GetLocation();
+			HitscanSubsystem -> QueueShot(MoveTemp(Shot));
+		}
+
+		LastMuzzleTransform = SocketTransform;
+		LastMuzzleSampleTime = CurrentTime;
+		LastMuzzleSampleFrame = GFrameCounter;
+	}
+}
+
+void AShooterCharacter::SampleMuzzleTransform()
+{
+	if(EquippedWeapon == nullptr) return;
+	if(const USkeletalMeshSocket* BarrelSocket = EquippedWeapon -> GetItemMesh() -> GetSocketByName("BarrelSocket"))
+	{
+		LastMuzzleTransform = BarrelSocket -> GetSocketTransform(EquippedWeapon -> GetItemMesh());
+		LastMuzzleSampleTime = GetWorld() -> GetTimeSeconds();
+		LastMuzzleSampleFrame = GFrameCounter;
+	}
+}
+
+void AShooterCharacter::ResolveBullet(const FHitscanShot& Shot, const FHitResult& BeamHitResult)
+{
+	if(!BeamHitResult.bBlockingHit) return;
+	
+	if(BeamHitResult.GetActor())
+	{
+		// Does hit actor implement BulletHitInterface?
+		IBulletHitInterface* BulletHitInterface = Cast<IBulletHitInterface>(BeamHitResult.GetActor());
+		if(BulletHitInterface)
+		{
+			BulletHitInterface -> BulletHit_Implementation(BeamHitResult);
+		}
+		
+		AEnemy* HitEnemy = Cast<AEnemy>(BeamHitResult.GetActor());
+		if(HitEnemy)
+		{
+			const EHitZone HitZone{ HitEnemy -> GetHitZone(BeamHitResult) };
+			const bool bHeadShot{ HitZone == EHitZone::EHZ_Head };
+			const float ZoneDamage{ (bHeadShot ? Shot.HeadshotDamage : Shot.Damage) *
+				HitEnemy -> GetHitZoneDamageMultiplier(HitZone) };
 			
-			if(BulletImpactParticles)
+			// Hits on the same enemy are merged and applied once at the end of the frame
+			UCombatDamageSubsystem* DamageSubsystem = GetWorld() -> GetSubsystem<UCombatDamageSubsystem>();
+			if(DamageSubsystem)
 			{
-				UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), BulletImpactParticles, BeamHitResult.Location);
+				DamageSubsystem -> QueueDamage(HitEnemy, ZoneDamage, GetController(), Shot.Weapon.Get(),
+					BeamHitResult.Location, bHeadShot);
 			}
-
-			if(BeamParticles)
+			else
 			{
-				UParticleSystemComponent* Beam = UGameplayStatics::SpawnEmitterAtLocation(
-					GetWorld(), BeamParticles, SocketTransform);
-				if(Beam)
-				{
-					Beam -> SetVectorParameter(FName("Target"), BeamHitResult.Location);
-				}
+				float Damage = UGameplayStatics::ApplyDamage(HitEnemy,
+					ZoneDamage, GetController(), Shot.Weapon.Get(), UDamageType::StaticClass());
+				UHitNumberManager::ShowWorldHitNumber(this, HitEnemy, Damage, BeamHitResult.Location, bHeadShot);
+				IHitReactionInterface::Execute_HitReact(HitEnemy, 1);
 			}
 		}
 	}
+	else
+	{ // Spawn default particles
+		if(BulletImpactParticles)
+		{
+			UParticlePoolSubsystem::SpawnPooledEmitter(this, BulletImpactParticles, FTransform(BeamHitResult.Location));
+		}
+	}
+	
+	if(BulletImpactParticles)
+	{
+		UParticlePoolSubsystem::SpawnPooledEmitter(this, BulletImpactParticles, FTransform(BeamHitResult.Location));
+	}
+
+	if(BeamParticles)
+	{
+		UParticleSystemComponent* Beam = UParticlePoolSubsystem::SpawnPooledEmitter(
+			this, BeamParticles, Shot.MuzzleTransform);
+		if(Beam)
+		{
+			Beam -> SetVectorParameter(FName("Target"), BeamHitResult.Location);
+		}
+	}
 }
 
 void AShooterCharacter::PlayHipFireMontage() const
@@ -812,26 +944,23 @@ void AShooterCharacter::FinishReloading()
 	if(EquippedWeapon == nullptr) return;
 	const auto AmmoType = EquippedWeapon -> GetAmmoType();
 	
-	if(AmmoMap.Contains(AmmoType))
-	{
-		int32 CarriedAmmo = AmmoMap[AmmoType];
-		const int32 MagEmptySpace = EquippedWeapon -> GetMagazineCapacity() - EquippedWeapon -> GetAmmo();
+	int32 CarriedAmmo = InventoryComponent -> GetAmmo(AmmoType);
+	const int32 MagEmptySpace = EquippedWeapon -> GetMagazineCapacity() - EquippedWeapon -> GetAmmo();
 
-		if(CarriedAmmo < MagEmptySpace)
-		{
-			// Reload the magazine with all the ammo we are carrying
-			EquippedWeapon -> ReloadAmmo(CarriedAmmo);
-			CarriedAmmo = 0;
-		}
-		else
-		{
-			// Fully fill the magazine
-			EquippedWeapon -> ReloadAmmo(MagEmptySpace);
-			CarriedAmmo -= MagEmptySpace;
-		}
-		// Assign the value to AmmoMap
-		AmmoMap.Add(AmmoType, CarriedAmmo);
+	if(CarriedAmmo < MagEmptySpace)
+	{
+		// Reload the magazine with all the ammo we are carrying
+		EquippedWeapon -> ReloadAmmo(CarriedAmmo);
+		CarriedAmmo = 0;
+	}
+	else
+	{
+		// Fully fill the magazine
+		EquippedWeapon -> ReloadAmmo(MagEmptySpace);
+		CarriedAmmo -= MagEmptySpace;
 	}
+	// Put the rest back in the inventory
+	InventoryComponent -> SetAmmo(AmmoType, CarriedAmmo);
 }
 
 void AShooterCharacter::FinishEquipping()
@@ -848,12 +977,7 @@ bool AShooterCharacter::CarryingAmmo()
 {
 	if(EquippedWeapon == nullptr) return false;
 
-	const auto AmmoType = EquippedWeapon -> GetAmmoType();
-	if(AmmoMap.Contains(AmmoType))
-	{
-		return AmmoMap[AmmoType] > 0;
-	}
-	return false;
+	return InventoryComponent -> GetAmmo(EquippedWeapon -> GetAmmoType()) > 0;
 }
 
 void AShooterCharacter::GrabClip()
@@ -939,19 +1063,21 @@ void AShooterCharacter::FinishLanding()
 void AShooterCharacter::PickupAmmo(AAmmo* Ammo)
 {
 	const EAmmoType AmmoType{ Ammo -> GetAmmoType() };
-	if(AmmoMap.Contains(AmmoType)) // if the ammo type is registered and valid
+	if(AmmoType == EAmmoType::EAT_Max) return; // Not a valid ammo type
+
+	InventoryComponent -> AddAmmo(AmmoType, Ammo -> GetItemCount());
+	// We are inside the ammo's own FinishInterping, hand it back to the pool once that returned
+	Ammo -> SetActorHiddenInGame(true);
+	GetWorldTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(Ammo, [Ammo]()
 	{
-		int32 AmmoCount{ AmmoMap[AmmoType] };
-		AmmoCount += Ammo -> GetItemCount();
-		AmmoMap[AmmoType] = AmmoCount;
-		Ammo -> Destroy();
-		
-		if(EquippedWeapon == nullptr) return; // If we are holding a weapon
-		// and it is empty and uses the same ammo type, after gathering ammo automatically reload it
-		if(EquippedWeapon -> GetAmmoType() == AmmoType && EquippedWeapon -> GetAmmo() == 0)
-		{
-			ReloadWeapon();
-		}
+		UItemPoolSubsystem::ReleasePooledItem(Ammo);
+	}));
+	
+	if(EquippedWeapon == nullptr) return; // If we are holding a weapon
+	// and it is empty and uses the same ammo type, after gathering ammo automatically reload it
+	if(EquippedWeapon -> GetAmmoType() == AmmoType && EquippedWeapon -> GetAmmo() == 0)
+	{
+		ReloadWeapon();
 	}
 }
 
@@ -1027,45 +1153,18 @@ void AShooterCharacter::EquipWeaponFive()
 
 void AShooterCharacter::EquipNextWeapon()
 {
-	if(Inventory.Num() <= 1) return;
+	if(InventoryComponent -> GetNumItems() <= 1) return;
 	
 	const int32 Index = EquippedWeapon -> GetSlotIndex();
-	
-	if(Inventory.Last() == Inventory[Index])
-	{
-		ExchangeInventoryItems(Index, 0);
-		return;
-	}
-
-	ExchangeInventoryItems(Index, Index + 1);
+	ExchangeInventoryItems(Index, InventoryComponent -> GetNextOccupiedSlot(Index));
 }
 
 void AShooterCharacter::EquipPreviousWeapon()
 {
-	if(Inventory.Num() <= 1) return;
-	const int32 Index = EquippedWeapon -> GetSlotIndex();
+	if(InventoryComponent -> GetNumItems() <= 1) return;
 	
-	if(Inventory[0] == Inventory[Index])
-	{
-		ExchangeInventoryItems(Index, Inventory.Num() - 1);
-		return;
-	}
-
-	ExchangeInventoryItems(Index, Index - 1);
-}
-
-int32 AShooterCharacter::GetEmptyInventorySlotIndex()
-{
-	for(int32 i = 0; i < Inventory.Num(); i++)
-	{
-		if(Inventory[i] == nullptr)
-			return i;
-	}
-	if(Inventory.Num() < INVENTORY_CAPACITY)
-	{
-		return Inventory.Num();
-	}
-	return -1; // No empty slots
+	const int32 Index = EquippedWeapon -> GetSlotIndex();
+	ExchangeInventoryItems(Index, InventoryComponent -> GetPreviousOccupiedSlot(Index));
 }
 
 EPhysicalSurface AShooterCharacter::GetSurfaceType()
@@ -1107,15 +1206,12 @@ void AShooterCharacter::EndStun()
 
 void AShooterCharacter::HighlightInventorySlot()
 {
-	const int32 EmptySlotIndex = GetEmptyInventorySlotIndex();
-	HighlightIconDelegate.Broadcast(EmptySlotIndex, true);
-	HighlightedSlotIndex = EmptySlotIndex;
+	InventoryComponent -> HighlightFreeSlot();
 }
 
 void AShooterCharacter::UnHighlightInventorySlot()
 {
-	HighlightIconDelegate.Broadcast(HighlightedSlotIndex, false);
-	HighlightedSlotIndex = -1; // Highlighted slot is empty(null) now.
+	InventoryComponent -> UnHighlightSlot();
 }
 
 void AShooterCharacter::Stun()
@@ -1143,6 +1239,8 @@ void AShooterCharacter::Tick(float DeltaTime)
 	SetLookRates();
 	// Calculate crosshair spread multiplier
 	CalculateCrosshairSpread(DeltaTime);
+	// Fire the shots which became due during this frame
+	UpdateFireScheduler(DeltaTime);
 	// Trace for items while overlapping items
 	PickupTrace();
 	// Interpolation for CapsuleHalfHeight while standing/crouching
@@ -1189,20 +1287,54 @@ float AShooterCharacter::GetCrosshairSpreadMultiplier() const
 	return CrosshairSpreadingMultiplier;
 }
 
-void AShooterCharacter::IncrementOverlappedItemCount(int8 Value)
+TArray<AItem*> AShooterCharacter::GetInventoryItems() const
+{
+	return Inventory;
+}
+
+int32 AShooterCharacter::GetAmmoCount(EAmmoType AmmoType) const
 {
-	if(OverlappedItemCount + Value <= 0)
+	return InventoryComponent -> GetAmmo(AmmoType);
+}
+
+int32 AShooterCharacter::GetHighlightedSlotIndex() const
+{
+	return InventoryComponent -> GetHighlightedSlotIndex();
+}
+
+void AShooterCharacter::ForwardEquipItem(int32 CurrentSlotIndex, int32 NewSlotIndex)
+{
+	EquipItemDelegate.Broadcast(CurrentSlotIndex, NewSlotIndex);
+}
+
+void AShooterCharacter::ForwardHighlightIcon(int32 SlotIndex, bool bStartAnimation)
+{
+	HighlightIconDelegate.Broadcast(SlotIndex, bStartAnimation);
+}
+
+void AShooterCharacter::MirrorInventorySlot(int32 SlotIndex)
+{
+	AItem* Item = InventoryComponent -> GetItem(SlotIndex);
+	if(Item && Inventory.Num() <= SlotIndex)
 	{
-		OverlappedItemCount = 0;
-		bShouldTraceForItems = false;
+		Inventory.SetNumZeroed(SlotIndex + 1);
 	}
-	else
+	if(Inventory.IsValidIndex(SlotIndex))
+	{
+		Inventory[SlotIndex] = Item;
+	}
+	// Like the old inventory array, Num() is one past the last item
+	while(Inventory.Num() > 0 && Inventory.Last() == nullptr)
 	{
-		OverlappedItemCount += Value;
-		bShouldTraceForItems = true;
+		Inventory.Pop();
 	}
 }
 
+void AShooterCharacter::MirrorInventoryAmmo(EAmmoType AmmoType)
+{
+	AmmoMap.Add(AmmoType, InventoryComponent -> GetAmmo(AmmoType));
+}
+
 FInterpLocation AShooterCharacter::GetInterpLocation(int32 Index)
 {
 	if(Index < InterpLocations.Num())
@@ -1243,9 +1375,9 @@ void AShooterCharacter::PickupItem(AItem* Item)
 	auto Weapon = Cast<AWeapon>(Item);
 	if(Weapon)
 	{
-		if(Inventory.Num() < INVENTORY_CAPACITY)
+		if(!InventoryComponent -> IsFull())
 		{
-			AddToInventory(Weapon);
+			InventoryComponent -> AddItem(Weapon);
 		}
 		else // Inventory is full. swapping it with the current equipped weapon.
 		{
@@ -1275,4 +1407,93 @@ void AShooterCharacter::StartEquipSoundTimer()
 	GetWorld() -> GetTimerManager().SetTimer(EquipSoundTimer, this,
 		&AShooterCharacter::ResetEquipSoundTimer, EquipSoundTimerDuration);
 	
-}
\ No newline at end of file
+}
+
+void AShooterCharacter::CaptureCombatSnapshot(FCombatSnapshot& OutSnapshot) const
+{
+	OutSnapshot.Health = Health;
+
+	OutSnapshot.Ammo.SetNumUninitialized(static_cast<int32>(EAmmoType::EAT_Max));
+	for(int32 i = 0; i < OutSnapshot.Ammo.Num(); i++)
+	{
+		OutSnapshot.Ammo[i] = InventoryComponent -> GetAmmo(static_cast<EAmmoType>(i));
+	}
+
+	OutSnapshot.Weapons.Reset(InventoryComponent -> GetNumItems());
+	for(int32 Slot = 0; Slot < InventoryComponent -> GetCapacity(); Slot++)
+	{
+		const AWeapon* Weapon = Cast<AWeapon>(InventoryComponent -> GetItem(Slot));
+		if(Weapon == nullptr) continue;
+
+		FWeaponSnapshot& WeaponSnapshot = OutSnapshot.Weapons.AddDefaulted_GetRef();
+		WeaponSnapshot.WeaponClassPath = Weapon -> GetClass() -> GetPathName();
+		WeaponSnapshot.WeaponType = Weapon -> GetWeaponType();
+		WeaponSnapshot.Ammo = Weapon -> GetAmmo();
+		WeaponSnapshot.SlotIndex = static_cast<int8>(Slot);
+	}
+	OutSnapshot.EquippedSlotIndex = EquippedWeapon ? static_cast<int8>(EquippedWeapon -> GetSlotIndex()) : INDEX_NONE;
+}
+
+void AShooterCharacter::RestoreCombatSnapshot(const FCombatSnapshot& Snapshot)
+{
+	Health = FMath::Clamp(Snapshot.Health, 0.f, MaxHealth);
+	CombatState = ECombatState::ECS_Unoccupied;
+
+	for(int32 i = 0; i < static_cast<int32>(EAmmoType::EAT_Max); i++)
+	{
+		InventoryComponent -> SetAmmo(static_cast<EAmmoType>(i), Snapshot.Ammo.IsValidIndex(i) ? Snapshot.Ammo[i] : 0);
+	}
+
+	// Return the weapons we are carrying to the pool
+	EquippedWeapon = nullptr;
+	for(int32 Slot = 0; Slot < InventoryComponent -> GetCapacity(); Slot++)
+	{
+		if(AItem* Item = InventoryComponent -> RemoveItem(Slot))
+		{
+			UItemPoolSubsystem::ReleasePooledItem(Item);
+		}
+	}
+
+	// Resolve every weapon class first, so the pools are filled in one go before any weapon is acquired
+	UItemPoolSubsystem* ItemPool = GetWorld() -> GetSubsystem<UItemPoolSubsystem>();
+	TArray<TSubclassOf<AWeapon>, TInlineAllocator<8>> WeaponClasses;
+	TMap<UClass*, int32, TInlineSetAllocator<8>> WeaponClassCounts;
+	for(const FWeaponSnapshot& WeaponSnapshot : Snapshot.Weapons)
+	{
+		UClass* WeaponClass = FSoftClassPath(WeaponSnapshot.WeaponClassPath).TryLoadClass<AWeapon>();
+		WeaponClasses.Add(WeaponClass);
+		if(WeaponClass) WeaponClassCounts.FindOrAdd(WeaponClass)++;
+	}
+	if(ItemPool)
+	{
+		for(const TPair<UClass*, int32>& WeaponClassCount : WeaponClassCounts)
+		{
+			ItemPool -> Prewarm(WeaponClassCount.Key, WeaponClassCount.Value);
+		}
+	}
+
+	for(int32 i = 0; i < Snapshot.Weapons.Num(); i++)
+	{
+		const FWeaponSnapshot& WeaponSnapshot = Snapshot.Weapons[i];
+		if(WeaponClasses[i] == nullptr) continue;
+
+		AWeapon* Weapon = ItemPool ? ItemPool -> AcquireItem<AWeapon>(WeaponClasses[i], GetActorTransform())
+			: GetWorld() -> SpawnActor<AWeapon>(WeaponClasses[i], GetActorTransform());
+		if(Weapon == nullptr) continue;
+
+		Weapon -> SetWeaponType(WeaponSnapshot.WeaponType);
+		Weapon -> LoadWeaponAssetsNow();
+		Weapon -> SetAmmo(WeaponSnapshot.Ammo);
+		Weapon -> DisableGlowMaterial();
+		Weapon -> SetCharacter(this);
+		Weapon -> SetItemState(EItemState::EIS_PickedUp);
+		InventoryComponent -> SetItem(WeaponSnapshot.SlotIndex, Weapon);
+	}
+
+	AWeapon* WeaponToEquip = Cast<AWeapon>(InventoryComponent -> GetItem(Snapshot.EquippedSlotIndex));
+	if(WeaponToEquip == nullptr) // Fall back to the first weapon we have
+	{
+		WeaponToEquip = Cast<AWeapon>(InventoryComponent -> GetItem(InventoryComponent -> GetNextOccupiedSlot(INDEX_NONE)));
+	}
+	EquipWeapon(WeaponToEquip);
+}
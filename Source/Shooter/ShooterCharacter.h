@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "AmmoType.h"
+#include "HitReactionInterface.h"
+#include "InventoryComponent.h"
 #include "ShooterCharacter.generated.h"
 
 UENUM(BlueprintType)
@@ -33,11 +35,28 @@ struct FInterpLocation
 	int32 ItemCount;
 };
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FEquipItemDelegate, int32, CurrentSlotIndex, int32, NewSlotIndex);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHighlightIconDelegate, int32, SlotIndex, bool, bStartAnimation);
+/** Result of the crosshair trace, shared by every caller within the same frame */
+struct FCrosshairTraceCache
+{
+	/** Frame the cached trace was performed in */
+	uint64 FrameNumber{ MAX_uint64 };
+
+	/** Camera view point the cached trace was performed from */
+	FVector ViewLocation{ FVector::ZeroVector };
+	FRotator ViewRotation{ FRotator::ZeroRotator };
+
+	FHitResult HitResult;
+	bool bBlockingHit{ false };
+
+	/** True when the cached trace was made this frame from the same camera view point */
+	bool IsValidFor(uint64 Frame, const FVector &Location, const FRotator &Rotation) const
+	{
+		return FrameNumber == Frame && ViewLocation.Equals(Location) && ViewRotation.Equals(Rotation);
+	}
+};
 
 UCLASS()
-class SHOOTER_API AShooterCharacter : public ACharacter
+class SHOOTER_API AShooterCharacter : public ACharacter, public IHitReactionInterface
 {
 	GENERATED_BODY()
 
@@ -47,6 +66,9 @@ public:
 
 	virtual float TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser) override;
 
+	/** Roll the stun once for all the hits merged this frame */
+	virtual void HitReact_Implementation(int32 HitCount) override;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -89,6 +111,11 @@ protected:
 	 */
 	void FireWeapon();
 
+	/** Fire a batch of shots in one go
+	 *  @param ShotTimes World time each shot was due at, oldest first
+	 */
+	void FireShots(TArrayView<const float> ShotTimes);
+
 	/** Set bAiming to true or false with button pressed */
 	void AimingButtonPressed();
 
@@ -98,15 +125,22 @@ protected:
 	void Aim();
 	void StopAiming();
 
-	/** Perform a line trace from crosshair screen location outward */
+	/** Perform a line trace from crosshair screen location outward.
+	 *  The result is cached per frame and camera view point, so repeated calls reuse a single trace
+	 */
 	bool LineTraceFromCrosshair(FHitResult &OutHitResult) const;
 
-	/** Perform a second line trace from gun barrel to where the beam ends and mix the two trace together
-	 *  and get the end location vector
+	/** Get the world space ray going through the crosshair
+	 *  @return False if the crosshair couldn't be deprojected
+	 */
+	bool GetCrosshairRay(FVector &OutStart, FVector &OutDirection) const;
+
+	/** Get the segment for the second line trace from gun barrel to where the crosshair trace ends
 	 *  @param MuzzleSocketLocation The location of gun barrel tip and where Muzzle particle spawns
-	 *  @param OutHitResult Give out the location of where beam trace ends
+	 *  @param OutTraceEnd Give out the end of the trace starting from the gun barrel
+	 *  @param OutBeamLocation Give out the location of where crosshair trace ends
 	 */
-	bool LineTraceFromGunBarrel(const FVector &MuzzleSocketLocation, FHitResult &OutHitResult) const;
+	void GetGunBarrelTrace(const FVector &MuzzleSocketLocation, FVector &OutTraceEnd, FVector &OutBeamLocation) const;
 
 	/** Calculate camera interpolation zoom */
 	void HandleCameraInterpZoom(float DeltaTime);
@@ -126,13 +160,17 @@ protected:
 	/** Automatic fire loop */
 	void FireButtonPressed();
 	void FireButtonReleased();
-	void StartFireRateTimer();
-	UFUNCTION()
-	void FireRateTimerReset();
+	void StartFireCooldown();
 
-	/** Trace for items if OverlappedItemCount > 0 */
+	/** Emit every shot that became due during this frame, based on the weapon's fire rate */
+	void UpdateFireScheduler(float DeltaTime);
+
+	/** Find the item aimed at among the items in pickup range, and highlight it */
 	void PickupTrace();
 
+	/** Ask the item registry for the pickup item closest to the crosshair, no traces involved */
+	class AItem* FindPickupItem() const;
+
 	/** Spawn default Weapon for the character */
 	class AWeapon* SpawnDefaultWeapon() const;
 
@@ -151,8 +189,8 @@ protected:
 	/** Drops currently equipped Weapon and equips PickupTraceHitItem */
 	void SwapWeapon(AWeapon* WeaponToSwap);
 
-	/** Initialize the AmmoMap with ammo values */
-	void InitializeAmmoMap();
+	/** Give the inventory its starting ammo */
+	void InitializeAmmo();
 
 	/** Return true if EquippedWeapon has ammo */
 	bool WeaponHasAmmo() const;
@@ -160,8 +198,14 @@ protected:
 	/** Play firing sound */
 	void PlayFireSound() const;
 
-	/** Perform linetrace for shooting and gathering information */
-	void SendBullet() const;
+	/** Spawn muzzle flash and queue a trace for each shot in the HitscanSubsystem
+	 *  @param ShotTimes World time each shot was due at, each one leaves the barrel from where it was at that time.
+	 *  They all aim at the crosshair trace of this frame
+	 */
+	void SendBullets(TArrayView<const float> ShotTimes);
+
+	/** Remember where the barrel is this frame, shots due during the next frame are interpolated from it */
+	void SampleMuzzleTransform();
 
 	/** Play HipFire montage animation */
 	void PlayHipFireMontage() const;
@@ -213,13 +257,19 @@ protected:
 	/** Create FInterpLocation structs for each location, and add them to the array */
 	void InitializeInterpLocations();
 
-	/** Handle adding items to the inventory by filling order */
-	void AddToInventory(AWeapon* Weapon);
-	
-	/** Handle replacing items in the inventory for a specific index */
-	void ReplaceInInventory(AWeapon* Weapon, int32 Index);
-	
 	void ExchangeInventoryItems(int32 CurrentItemIndex, int32 NewItemIndex);
+
+	/** Rebroadcast the Inventory component's equip event for the widgets bound to the character */
+	UFUNCTION()
+	void ForwardEquipItem(int32 CurrentSlotIndex, int32 NewSlotIndex);
+
+	/** Rebroadcast the Inventory component's highlight event for the widgets bound to the character */
+	UFUNCTION()
+	void ForwardHighlightIcon(int32 SlotIndex, bool bStartAnimation);
+
+	/** Keep Inventory and AmmoMap in step with the Inventory component */
+	void MirrorInventorySlot(int32 SlotIndex);
+	void MirrorInventoryAmmo(EAmmoType AmmoType);
 	
 	void EquipDefaultWeapon();
 	void EquipWeaponOne();
@@ -231,9 +281,6 @@ protected:
 	void EquipNextWeapon();
 	void EquipPreviousWeapon();
 
-	/** Return the first empty slot in our inventory list */
-	int32 GetEmptyInventorySlotIndex();
-
 	UFUNCTION(BlueprintCallable)
 	EPhysicalSurface GetSurfaceType();
 
@@ -390,6 +437,21 @@ private:
 
 	/** True when we can fire. False when waiting for the timer */
 	bool bShouldFire;
+
+	/** Time left until the next shot is allowed. Negative once a shot is overdue */
+	float FireCooldown;
+
+	/** Frame the fire cooldown started in, that frame's time isn't counted against it */
+	uint64 FireCooldownStartFrame;
+
+	/** Upper limit of shots fired in a single frame, to recover from long hitches */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	int32 MaxShotsPerFrame;
+
+	/** BarrelSocket transform at the end of the last frame spent firing */
+	FTransform LastMuzzleTransform;
+	float LastMuzzleSampleTime;
+	uint64 LastMuzzleSampleFrame;
 	
 	/** True while gun is firing */
 	bool bFiringBullet;
@@ -397,23 +459,21 @@ private:
 	/** Duration of crosshair spread for shooting */
 	float CrosshairShootingDuration;
 	
-	/** Sets a timer between gunshots */
-	FTimerHandle AutomaticFireRateTimer;
-
 	/** Sets a timer between crosshair spreads */
 	FTimerHandle CrosshairShootTimer;
 
-	/** True if we should trace items for every frame */
-	bool bShouldTraceForItems;
+	/** Crosshair trace shared by every caller within a frame */
+	mutable FCrosshairTraceCache CrosshairTraceCache;
 
-	/** Number of overlapped AItem */
-	int8 OverlappedItemCount;
+	/** Half angle in degrees of the view cone around the crosshair in which items can be picked */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = "true"))
+	float PickupConeHalfAngle;
 
-	/** The AItem we currently hit by our trace in PickupTrace (could we null) */
+	/** The AItem we currently aim at in PickupTrace (could be null) */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	class AItem* PickupTraceHitItem;
 	
-	/** The AItem we hit last frame in PickupTrace */
+	/** The AItem we aimed at last frame in PickupTrace */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Items , meta = (AllowPrivateAccess = "true"))
 	AItem* PreviousPickupTraceHitItem;
 
@@ -425,10 +485,6 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Combat , meta = (AllowPrivateAccess = "true"))
 	TSubclassOf<AWeapon> DefaultWeaponClass;
 
-	/** Map to keep track of ammo of different ammo types */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
-	TMap<EAmmoType, int32> AmmoMap;
-
 	/** Starting amount of 9mm ammo */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (AllowPrivateAccess = "true"))
 	int32 Starting9mmAmmo;
@@ -544,29 +600,35 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Items, meta = (AllowPrivateAccess = "true"))
 	float EquipSoundTimerDuration;
 
-	/** An array of AItems for our Inventory */
+	/** Weapon slots and carried ammo */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = "true"))
+	UInventoryComponent* InventoryComponent;
+
+	/** Items by slot index, mirrored from InventoryComponent for the widgets reading the character's array.
+	 *  Ends at the last occupied slot. Slots fill from the lowest, so free slots only show up as null holes
+	 *  after restoring a checkpoint with gaps */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = "true"))
 	TArray<AItem*> Inventory;
 
-	const int32 INVENTORY_CAPACITY{ 6 };
+	/** Carried ammo by type, mirrored from InventoryComponent for the widgets reading the character's map */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	TMap<EAmmoType, int32> AmmoMap;
 
-	/* Delegate for sending slot information to Inventory bar when equipping */
+	/* Delegate for sending slot information to Inventory bar when equipping, forwarded from the Inventory */
 	UPROPERTY(BlueprintAssignable, Category = Delegates, meta = (AllowPrivateAccess = "true"))
 	FEquipItemDelegate EquipItemDelegate;
 
-	/** Delegate for highlighting the selected slot in the Inventory */
-	UPROPERTY(VisibleAnywhere, BlueprintAssignable, Category = Inventory , meta = (AllowPrivateAccess = "true"))
+	/** Delegate for highlighting the selected slot in the Inventory, forwarded from the Inventory */
+	UPROPERTY(BlueprintAssignable, Category = Delegates, meta = (AllowPrivateAccess = "true"))
 	FHighlightIconDelegate HighlightIconDelegate;
-
-	/** Slot index of the highlighted slot */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = "true"))
-	int32 HighlightedSlotIndex;
 	
 public:
 	/** Returns CameraBoom subObject */
 	FORCEINLINE USpringArmComponent *GetCameraBoom() const { return CameraBoom; }
 	/** Returns FollowCamera subObject */
 	FORCEINLINE UCameraComponent* GetFollowCamera() const { return FollowCamera; }
+	/** Returns InventoryComponent subObject */
+	FORCEINLINE UInventoryComponent* GetInventoryComponent() const { return InventoryComponent; }
 	/** Returns current speed of the character in X and Y direction */
 	FORCEINLINE float GetCurrentSpeed() const { return CurrentSpeed; }
 	
@@ -575,9 +637,19 @@ public:
 	/** Returns CrosshairSpreadingMultiplier function */
 	UFUNCTION(BlueprintCallable)
 	float GetCrosshairSpreadMultiplier() const;
-	
-	FORCEINLINE int8 GetOverlappedItemCount() const { return OverlappedItemCount; }
 
+	/** Items by inventory slot up to the last occupied one, null for free slots in between */
+	UFUNCTION(BlueprintPure, Category = Inventory)
+	TArray<AItem*> GetInventoryItems() const;
+
+	/** Carried ammo of the type */
+	UFUNCTION(BlueprintPure, Category = Inventory)
+	int32 GetAmmoCount(EAmmoType AmmoType) const;
+
+	/** Slot index of the highlighted slot, -1 if none */
+	UFUNCTION(BlueprintPure, Category = Inventory)
+	int32 GetHighlightedSlotIndex() const;
+	
 	FORCEINLINE ECombatState GetCombatState() const { return CombatState; }
 
 	FORCEINLINE bool GetCrouching() const { return bCrouching; }
@@ -594,8 +666,11 @@ public:
 	
 	FORCEINLINE UParticleSystem* GetBloodParticles() const { return BloodParticles; }
 
-	/** Add/subtract OverlappedItemCount and updates bShouldTraceForItems */
-	void IncrementOverlappedItemCount(int8 Value);
+	/** Handle the hit of a shot, once the HitscanSubsystem has its trace result
+	 *  @param Shot The shot queued by SendBullets
+	 *  @param BeamHitResult Result of the trace from the gun barrel
+	 */
+	void ResolveBullet(const struct FHitscanShot &Shot, const FHitResult &BeamHitResult);
 
 	/** Get the desired interp location based on an Index in the array */
 	FInterpLocation GetInterpLocation(int32 Index);
@@ -618,4 +693,10 @@ public:
 	void UnHighlightInventorySlot();
 
 	void Stun();
+
+	/** Copy health, ammo and inventory into a plain data snapshot */
+	void CaptureCombatSnapshot(struct FCombatSnapshot& OutSnapshot) const;
+
+	/** Restore health, ammo and inventory, respawning the inventory weapons in one batch */
+	void RestoreCombatSnapshot(const FCombatSnapshot& Snapshot);
 };
\ No newline at end of file
@@ -2,11 +2,12 @@
 
 
 #include "ShooterPlayerController.h"
+#include "HitNumberManager.h"
 #include "Blueprint/UserWidget.h"
 
 AShooterPlayerController::AShooterPlayerController()
 {
-	
+	HitNumberManager = CreateDefaultSubobject<UHitNumberManager>(TEXT("HitNumberManager"));
 }
 
 void AShooterPlayerController::BeginPlay()
@@ -25,5 +25,11 @@ private:
 	/** Variable to hold the HUD Overlay Widget after creating it */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widgets", meta = (AllowPrivateAccess = "true"))
 	UUserWidget* HUDOverlay;
-	
+
+	/** Shows the hit numbers of every enemy from a pool of widgets */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widgets", meta = (AllowPrivateAccess = "true"))
+	class UHitNumberManager* HitNumberManager;
+
+public:
+	FORCEINLINE UHitNumberManager* GetHitNumberManager() const { return HitNumberManager; }
 };
@@ -3,6 +3,10 @@
 
 #include "Weapon.h"
 
+#include "BakedCurveSubsystem.h"
+#include "WeaponDataSubsystem.h"
+#include "Engine/Engine.h"
+
 AWeapon::AWeapon():
 	ThrowWeaponDuration(0.7f),
 	bFalling(false),
@@ -21,9 +25,12 @@ AWeapon::AWeapon():
 	SlideDuration(0.2f),
 	MaxSlideDisplacement(4.f),
 	bMovingSlide(false),
+	BakedSlideDisplacementCurve(nullptr),
 	RecoilRotation(0.f),
 	MaxRecoilRotation(20.f),
-	bAutomatic(true)
+	bAutomatic(true),
+	RequestedAssetsType(EWeaponType::EWT_DefaultMax),
+	AppliedAssetsType(EWeaponType::EWT_DefaultMax)
 {
 	PrimaryActorTick.bCanEverTick = true;
 }
@@ -54,10 +61,21 @@ void AWeapon::BeginPlay()
 	Super::BeginPlay();
 
 	LoadWeaponTypeData();
-	if(bShouldHideBone && BoneToHide != TEXT(""))
-	{
-		GetItemMesh() -> HideBoneByName(BoneToHide, PBO_None);
-	}
+}
+
+void AWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseWeaponAssets();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AWeapon::BeginDestroy()
+{
+	// Weapons that never got to EndPlay still hold their request
+	ReleaseWeaponAssets();
+
+	Super::BeginDestroy();
 }
 
 void AWeapon::ThrowWeapon()
@@ -78,6 +96,7 @@ void AWeapon::ThrowWeapon()
 	
 	GetItemMesh() -> AddImpulse(ImpulseDirection);
 	bFalling = true;
+	RefreshTickEnabled();
 
 	GetWorldTimerManager().SetTimer(ThrowWeaponTimer, this, &AWeapon::StopFalling, ThrowWeaponDuration);
 	
@@ -93,68 +112,160 @@ void AWeapon::StopFalling()
 
 void AWeapon::LoadWeaponTypeData()
 {
-	
-	const FString WeaponTablePath{TEXT("DataTable'/Game/_Game/DataTables/WeaponDataTable.WeaponDataTable'")};
-	UDataTable* WeaponTableObject = Cast<UDataTable>(StaticLoadObject(UDataTable::StaticClass(), nullptr, *WeaponTablePath));
+	// Resolved once per weapon type by the subsystem, no table lookup per weapon
+	const FWeaponDataTable* WeaponDataRow{ UWeaponDataSubsystem::FindWeaponData(WeaponType) };
+	if(WeaponDataRow == nullptr) return;
+
+	SetItemName(WeaponDataRow -> WeaponName);
+	AmmoType = WeaponDataRow -> AmmoType;
+	Ammo = WeaponDataRow -> StartingAmmo;
+	MagazineCapacity = WeaponDataRow -> MagazineCapacity;
+	Damage = WeaponDataRow -> Damage;
+	HeadshotDamage = WeaponDataRow -> HeadshotDamage;
+	SetGlowMaterialIndex(WeaponDataRow -> GlowMaterialIndex);
+	ClipBoneName = WeaponDataRow -> ClipBoneName;
+	ReloadMontageSection = WeaponDataRow -> ReloadMontageSectionName;
+	AutoFireRate = WeaponDataRow -> AutoFireRate;
+	bShouldHideBone = WeaponDataRow -> bShouldHideBone;
+	BoneToHide = WeaponDataRow -> BoneToHide;
+	MaxSlideDisplacement = WeaponDataRow -> MaxSlideDisplacement;
+	MaxRecoilRotation = WeaponDataRow -> MaxRecoilRotation;
+	SlideDuration = WeaponDataRow -> SlideDuration;
+	bAutomatic = WeaponDataRow -> bAutomatic;
 
-	if(WeaponTableObject)
+	if(GetWorld() && GetWorld() -> IsGameWorld())
 	{
-		FWeaponDataTable* WeaponDataRow = nullptr;
-		switch(WeaponType)
+		// Assets are applied once streamed in. Only requested from BeginPlay on, EndPlay is what releases them
+		if(HasActorBegunPlay() || IsActorBeginningPlay())
 		{
-		case EWeaponType::EWT_SubmachineGun:
-			WeaponDataRow = WeaponTableObject -> FindRow<FWeaponDataTable>(TEXT("SubmachineGun"), TEXT(""));
-			break;
-		case EWeaponType::EWT_AssaultRiffle:
-			WeaponDataRow = WeaponTableObject -> FindRow<FWeaponDataTable>(TEXT("AssaultRiffle"), TEXT(""));
-			break;
-		case EWeaponType::EWT_Pistol:
-			WeaponDataRow = WeaponTableObject -> FindRow<FWeaponDataTable>(TEXT("Pistol"), TEXT(""));
+			RequestWeaponAssets();
 		}
+	}
+	else // Editor preview, load what's missing right away
+	{
+		ApplyWeaponAssets(*WeaponDataRow, true);
+	}
+}
+
+void AWeapon::ApplyWeaponAssets(const FWeaponDataTable& WeaponDataRow, bool bLoadSynchronous)
+{
+	auto Resolve = [bLoadSynchronous](const auto& SoftReference)
+	{
+		return bLoadSynchronous ? SoftReference.LoadSynchronous() : SoftReference.Get();
+	};
+
+	GetItemMesh() -> SetSkeletalMesh(Resolve(WeaponDataRow.WeaponMesh));
+	SetItemIcon(Resolve(WeaponDataRow.WeaponIcon));
+	SetAmmoTypeIcon(Resolve(WeaponDataRow.AmmoTypeIcon));
+	SetPickupSound(Resolve(WeaponDataRow.PickupSound));
+	SetEquipSound(Resolve(WeaponDataRow.EquipSound));
+	GetItemMesh() -> SetAnimInstanceClass(Resolve(WeaponDataRow.AnimBP));
+	CrosshairMiddle = Resolve(WeaponDataRow.CrosshairMiddle);
+	CrosshairRight = Resolve(WeaponDataRow.CrosshairRight);
+	CrosshairLeft = Resolve(WeaponDataRow.CrosshairLeft);
+	CrosshairTop = Resolve(WeaponDataRow.CrosshairTop);
+	CrosshairBottom = Resolve(WeaponDataRow.CrosshairBottom);
+	MuzzleFlash = Resolve(WeaponDataRow.MuzzleFlash);
+	FireSound = Resolve(WeaponDataRow.FireSound);
+	SlideDisplacementCurve = Resolve(WeaponDataRow.SlideDisplacementCurve);
+	BakedSlideDisplacementCurve = UBakedCurveSubsystem::FindOrBakeCurve(this, SlideDisplacementCurve);
+
+	GetItemMesh() -> SetMaterial(GetPreviousMaterialIndex(), nullptr);
+	SetMaterialInstance(Resolve(WeaponDataRow.MaterialInstance));
+	if(GetMaterialInstance())
+	{
+		SetGlowMaterialInstanceDynamic(UMaterialInstanceDynamic::Create(GetMaterialInstance(), this));
+		GetGlowMaterialInstanceDynamic() -> SetVectorParameterValue(TEXT("FresnelColor"), GetGlowColor());
+		GetItemMesh() -> SetMaterial(GetGlowMaterialIndex(), GetGlowMaterialInstanceDynamic());
 
-		if(WeaponDataRow)
+		// The assets may stream in after the weapon was picked up or equipped, only weapons in the world glow
+		const bool bInWorld{ GetItemState() == EItemState::EIS_Pickup || GetItemState() == EItemState::EIS_Falling };
+		if(bInWorld)
 		{
-			SetItemName(WeaponDataRow -> WeaponName);
-			GetItemMesh() -> SetSkeletalMesh(WeaponDataRow -> WeaponMesh);
-			SetItemIcon(WeaponDataRow -> WeaponIcon);
-			SetAmmoTypeIcon(WeaponDataRow -> AmmoTypeIcon);
-			AmmoType = WeaponDataRow -> AmmoType;
-			Ammo = WeaponDataRow -> StartingAmmo;
-			MagazineCapacity = WeaponDataRow -> MagazineCapacity;
-			Damage = WeaponDataRow -> Damage;
-			HeadshotDamage = WeaponDataRow -> HeadshotDamage;
-			SetPickupSound(WeaponDataRow -> PickupSound);
-			SetEquipSound(WeaponDataRow -> EquipSound);
-			SetGlowMaterialIndex(WeaponDataRow -> GlowMaterialIndex);
-			ClipBoneName = WeaponDataRow -> ClipBoneName;
-			ReloadMontageSection = WeaponDataRow -> ReloadMontageSectionName;
-			GetItemMesh() -> SetAnimInstanceClass(WeaponDataRow -> AnimBP);
-			CrosshairMiddle = WeaponDataRow -> CrosshairMiddle;
-			CrosshairRight = WeaponDataRow -> CrosshairRight;
-			CrosshairLeft = WeaponDataRow -> CrosshairLeft;
-			CrosshairTop = WeaponDataRow -> CrosshairTop;
-			CrosshairBottom = WeaponDataRow -> CrosshairBottom;
-			AutoFireRate = WeaponDataRow -> AutoFireRate;
-			MuzzleFlash = WeaponDataRow -> MuzzleFlash;
-			FireSound = WeaponDataRow -> FireSound;
-			bShouldHideBone = WeaponDataRow -> bShouldHideBone;
-			BoneToHide = WeaponDataRow -> BoneToHide;
-			MaxSlideDisplacement = WeaponDataRow -> MaxSlideDisplacement;
-			MaxRecoilRotation = WeaponDataRow -> MaxRecoilRotation;
-			SlideDuration = WeaponDataRow -> SlideDuration;
-			SlideDisplacementCurve = WeaponDataRow -> SlideDisplacementCurve;
-			bAutomatic = WeaponDataRow -> bAutomatic;
-
-			GetItemMesh() -> SetMaterial(GetPreviousMaterialIndex(), nullptr);
-			SetMaterialInstance(WeaponDataRow -> MaterialInstance);
-			if(GetMaterialInstance())
-			{
-				SetGlowMaterialInstanceDynamic(UMaterialInstanceDynamic::Create(GetMaterialInstance(), this));
-				GetGlowMaterialInstanceDynamic() -> SetVectorParameterValue(TEXT("FresnelColor"), GetGlowColor());
-				GetItemMesh() -> SetMaterial(GetGlowMaterialIndex(), GetGlowMaterialInstanceDynamic());
-				EnableGlowMaterial();
-			}
+			EnableGlowMaterial();
 		}
+		else
+		{
+			DisableGlowMaterial();
+		}
+	}
+
+	if(bShouldHideBone && BoneToHide != TEXT(""))
+	{
+		GetItemMesh() -> HideBoneByName(BoneToHide, PBO_None);
+	}
+	AppliedAssetsType = WeaponType;
+	// The glow material may be new, it decides whether the weapon pulses
+	RefreshTickEnabled();
+}
+
+void AWeapon::RequestWeaponAssets()
+{
+	if(RequestedAssetsType == WeaponType) return; // Already requested, OnWeaponAssetsLoaded applies them
+	ReleaseWeaponAssets();
+
+	UWeaponDataSubsystem* WeaponDataSubsystem = GEngine ? GEngine -> GetEngineSubsystem<UWeaponDataSubsystem>() : nullptr;
+	if(WeaponDataSubsystem == nullptr) return;
+
+	RequestedAssetsType = WeaponType;
+	WeaponDataSubsystem -> RequestWeaponAssets(WeaponType,
+		FStreamableDelegate::CreateUObject(this, &AWeapon::OnWeaponAssetsLoaded, WeaponType));
+}
+
+void AWeapon::ReleaseWeaponAssets()
+{
+	if(RequestedAssetsType == EWeaponType::EWT_DefaultMax) return;
+
+	if(UWeaponDataSubsystem* WeaponDataSubsystem = GEngine ? GEngine -> GetEngineSubsystem<UWeaponDataSubsystem>() : nullptr)
+	{
+		WeaponDataSubsystem -> ReleaseWeaponAssets(RequestedAssetsType);
+	}
+	RequestedAssetsType = EWeaponType::EWT_DefaultMax;
+}
+
+void AWeapon::OnAcquiredFromPool()
+{
+	// Assets set in here see the released state and turn the glow off, the item turns it back on
+	LoadWeaponTypeData();
+
+	Super::OnAcquiredFromPool();
+}
+
+void AWeapon::OnReleasedToPool()
+{
+	bFalling = false;
+	bMovingSlide = false;
+	SlideDisplacement = 0.f;
+	RecoilRotation = 0.f;
+	ReleaseWeaponAssets();
+
+	Super::OnReleasedToPool();
+}
+
+void AWeapon::OnWeaponAssetsLoaded(EWeaponType LoadedType)
+{
+	// The type changed while loading, or LoadWeaponAssetsNow got there first
+	if(LoadedType != RequestedAssetsType || LoadedType == AppliedAssetsType) return;
+
+	const FWeaponDataTable* WeaponDataRow{ UWeaponDataSubsystem::FindWeaponData(LoadedType) };
+	if(WeaponDataRow)
+	{
+		ApplyWeaponAssets(*WeaponDataRow, false);
+	}
+}
+
+void AWeapon::LoadWeaponAssetsNow()
+{
+	if(AppliedAssetsType == WeaponType) return;
+
+	const FWeaponDataTable* WeaponDataRow{ UWeaponDataSubsystem::FindWeaponData(WeaponType) };
+	if(WeaponDataRow == nullptr) return;
+
+	// Keep holding the streaming request, and block on whatever hasn't streamed in yet
+	RequestWeaponAssets();
+	if(AppliedAssetsType != WeaponType)
+	{
+		ApplyWeaponAssets(*WeaponDataRow, true);
 	}
 }
 
@@ -162,11 +273,22 @@ void AWeapon::StartSlideTimer()
 {
 	bMovingSlide = true;
 	GetWorldTimerManager().SetTimer(SlideTimer, this,  &AWeapon::SlideTimerFinished, SlideDuration);
+	RefreshTickEnabled();
 }
 
 void AWeapon::SlideTimerFinished()
 {
 	bMovingSlide = false;
+	RefreshTickEnabled();
+}
+
+bool AWeapon::ShouldTick() const
+{
+	if(Super::ShouldTick()) return true;
+
+	const bool bKeepUpright{ GetItemState() == EItemState::EIS_Falling && bFalling };
+	const bool bUpdateSlide{ SlideDisplacementCurve && bMovingSlide };
+	return bKeepUpright || bUpdateSlide;
 }
 
 void AWeapon::UpdateSlideDisplacement()
@@ -174,7 +296,7 @@ void AWeapon::UpdateSlideDisplacement()
 	if(SlideDisplacementCurve && bMovingSlide)
 	{
 		const float ElapsedTime{ GetWorldTimerManager().GetTimerElapsed(SlideTimer) };
-		const float CurveValue{ SlideDisplacementCurve -> GetFloatValue(ElapsedTime) };
+		const float CurveValue{ UBakedCurveSubsystem::Evaluate(BakedSlideDisplacementCurve, SlideDisplacementCurve, ElapsedTime) };
 		SlideDisplacement = CurveValue * MaxSlideDisplacement;
 		RecoilRotation = CurveValue * MaxRecoilRotation;
 	}
@@ -191,3 +313,16 @@ void AWeapon::ReloadAmmo(int32 Amount)
 	checkf(Ammo + Amount <= MagazineCapacity, TEXT("Attempted to overfill the magazine"));
 	Ammo += Amount;
 }
+
+void AWeapon::SetWeaponType(EWeaponType Type)
+{
+	if(WeaponType == Type) return;
+
+	WeaponType = Type;
+	LoadWeaponTypeData();
+}
+
+void AWeapon::SetAmmo(int32 Amount)
+{
+	Ammo = FMath::Clamp(Amount, 0, MagazineCapacity);
+}
@@ -8,6 +8,9 @@
 #include "WeaponType.h"
 #include "Weapon.generated.h"
 
+/** Row of the weapon data table. Assets are soft references, streamed in by UWeaponDataSubsystem
+ *  while weapons of the type are in the world
+ */
 USTRUCT(BlueprintType)
 struct FWeaponDataTable : public FTableRowBase
 {
@@ -17,13 +20,13 @@ struct FWeaponDataTable : public FTableRowBase
 	FString WeaponName;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	USkeletalMesh* WeaponMesh;
+	TSoftObjectPtr<USkeletalMesh> WeaponMesh;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* WeaponIcon;
+	TSoftObjectPtr<UTexture2D> WeaponIcon;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* AmmoTypeIcon;
+	TSoftObjectPtr<UTexture2D> AmmoTypeIcon;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	EAmmoType AmmoType;
@@ -41,19 +44,19 @@ struct FWeaponDataTable : public FTableRowBase
 	int32 MagazineCapacity;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	USoundCue* PickupSound;
+	TSoftObjectPtr<USoundCue> PickupSound;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	USoundCue* EquipSound;
+	TSoftObjectPtr<USoundCue> EquipSound;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UMaterialInstance* MaterialInstance;
+	TSoftObjectPtr<UMaterialInstance> MaterialInstance;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 GlowMaterialIndex;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	TSubclassOf<UAnimInstance> AnimBP;
+	TSoftClassPtr<UAnimInstance> AnimBP;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FName ClipBoneName;
@@ -62,28 +65,28 @@ struct FWeaponDataTable : public FTableRowBase
 	FName ReloadMontageSectionName;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrosshairMiddle;
+	TSoftObjectPtr<UTexture2D> CrosshairMiddle;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrosshairRight;
+	TSoftObjectPtr<UTexture2D> CrosshairRight;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrosshairLeft;
+	TSoftObjectPtr<UTexture2D> CrosshairLeft;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrosshairTop;
+	TSoftObjectPtr<UTexture2D> CrosshairTop;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UTexture2D* CrosshairBottom;
+	TSoftObjectPtr<UTexture2D> CrosshairBottom;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float AutoFireRate;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UParticleSystem* MuzzleFlash;
+	TSoftObjectPtr<UParticleSystem> MuzzleFlash;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	USoundCue* FireSound;
+	TSoftObjectPtr<USoundCue> FireSound;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bShouldHideBone;
@@ -101,7 +104,7 @@ struct FWeaponDataTable : public FTableRowBase
 	float SlideDuration;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	UCurveFloat* SlideDisplacementCurve;
+	TSoftObjectPtr<UCurveFloat> SlideDisplacementCurve;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bAutomatic;
@@ -122,14 +125,43 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void BeginDestroy() override;
 	
 	void StopFalling();
 
 	void LoadWeaponTypeData();
+
+	/** Set the assets of the weapon type, from the streamed in soft references
+	 *  @param bLoadSynchronous Load assets that aren't resident yet, used outside of game worlds
+	 */
+	void ApplyWeaponAssets(const FWeaponDataTable& WeaponDataRow, bool bLoadSynchronous);
+
+	/** Ask the weapon data subsystem to stream in the assets of our weapon type */
+	void RequestWeaponAssets();
+
+	/** Let go of the streamed assets, they unload once no weapon of the type needs them */
+	void ReleaseWeaponAssets();
+
+	/** Called once the requested assets are resident
+	 *  @param LoadedType Weapon type the assets were requested for, stale if the type changed since
+	 */
+	void OnWeaponAssetsLoaded(EWeaponType LoadedType);
+
+	/** Reload the weapon type data, so the weapon comes back with its starting ammo */
+	virtual void OnAcquiredFromPool() override;
+
+	/** Stop throw and slide movement, and let go of the weapon type assets while pooled */
+	virtual void OnReleasedToPool() override;
 	
 	void SlideTimerFinished();
 
 	void UpdateSlideDisplacement();
+
+	/** Also tick while the thrown weapon is kept upright, or the pistol slide is moving */
+	virtual bool ShouldTick() const override;
 	
 private:
 	FTimerHandle ThrowWeaponTimer;
@@ -214,6 +246,9 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pistol" , meta = (AllowPrivateAccess = "true"))
 	UCurveFloat* SlideDisplacementCurve;
 
+	/** Lookup table of SlideDisplacementCurve, shared by all weapons of the type */
+	const struct FBakedCurve* BakedSlideDisplacementCurve;
+
 	FTimerHandle SlideTimer;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Pistol" , meta = (AllowPrivateAccess = "true"))
@@ -233,6 +268,12 @@ private:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon Properties" , meta = (AllowPrivateAccess = "true"))
 	bool bAutomatic;
+
+	/** Weapon type whose assets we hold a request for, EWT_DefaultMax if none */
+	EWeaponType RequestedAssetsType;
+
+	/** Weapon type whose assets are set on the weapon, EWT_DefaultMax if none */
+	EWeaponType AppliedAssetsType;
 	
 public:
 	/** Adds pulse to the Weapon */
@@ -256,6 +297,17 @@ public:
 
 	void ReloadAmmo(int32 Amount);
 
+	/** Switch to another weapon type, reloading its data if it changed */
+	void SetWeaponType(EWeaponType Type);
+
+	/** Load and set the assets of the weapon type right away, for weapons that go straight into an inventory
+	 *  and can't wait for the stream to fire or show their mesh
+	 */
+	void LoadWeaponAssetsNow();
+
+	/** Set the ammo in the magazine, clamped to its capacity */
+	void SetAmmo(int32 Amount);
+
 	FORCEINLINE bool ClipIsFull() const { return Ammo >= MagazineCapacity; }
 	FORCEINLINE void SetMovingClip(bool Moving) { bMovingClip = Moving; }
 };
\ No newline at end of file
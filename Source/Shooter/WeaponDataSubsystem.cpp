@@ -0,0 +1,172 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+
+#include "WeaponDataSubsystem.h"
+
+#include "Weapon.h"
+#include "Engine/DataTable.h"
+#include "Engine/Engine.h"
+
+void UWeaponDataSubsystem::Deinitialize()
+{
+	if(WeaponDataTable)
+	{
+		WeaponDataTable -> OnDataTableChanged().RemoveAll(this);
+	}
+	WeaponDataTable = nullptr;
+	WeaponData.Empty();
+	bWeaponDataBuilt = false;
+
+	for(FWeaponAssetRequest& Request : AssetRequests)
+	{
+		if(Request.Handle.IsValid())
+		{
+			Request.Handle -> ReleaseHandle();
+		}
+	}
+	AssetRequests.Empty();
+
+	Super::Deinitialize();
+}
+
+const FWeaponDataTable* UWeaponDataSubsystem::GetWeaponData(EWeaponType WeaponType)
+{
+	if(!bWeaponDataBuilt)
+	{
+		BuildWeaponData();
+	}
+	const int32 Index{ static_cast<int32>(WeaponType) };
+	return WeaponData.IsValidIndex(Index) ? WeaponData[Index] : nullptr;
+}
+
+const FWeaponDataTable* UWeaponDataSubsystem::FindWeaponData(EWeaponType WeaponType)
+{
+	UWeaponDataSubsystem* WeaponDataSubsystem = GEngine ? GEngine -> GetEngineSubsystem<UWeaponDataSubsystem>() : nullptr;
+	return WeaponDataSubsystem ? WeaponDataSubsystem -> GetWeaponData(WeaponType) : nullptr;
+}
+
+FName UWeaponDataSubsystem::GetWeaponRowName(EWeaponType WeaponType)
+{
+	switch(WeaponType)
+	{
+	case EWeaponType::EWT_SubmachineGun:
+		return FName("SubmachineGun");
+	case EWeaponType::EWT_AssaultRiffle:
+		return FName("AssaultRiffle");
+	case EWeaponType::EWT_Pistol:
+		return FName("Pistol");
+	default:
+		return NAME_None;
+	}
+}
+
+void UWeaponDataSubsystem::BuildWeaponData()
+{
+	bWeaponDataBuilt = true;
+	WeaponData.Init(nullptr, static_cast<int32>(EWeaponType::EWT_DefaultMax));
+
+	if(WeaponDataTable == nullptr)
+	{
+		WeaponDataTable = Cast<UDataTable>(WeaponDataTablePath.TryLoad());
+		if(WeaponDataTable == nullptr) return;
+		WeaponDataTable -> OnDataTableChanged().AddUObject(this, &UWeaponDataSubsystem::OnWeaponTableChanged);
+	}
+
+	for(int32 Index = 0; Index < WeaponData.Num(); Index++)
+	{
+		const FName RowName{ GetWeaponRowName(static_cast<EWeaponType>(Index)) };
+		WeaponData[Index] = WeaponDataTable -> FindRow<FWeaponDataTable>(RowName, TEXT("UWeaponDataSubsystem"));
+	}
+}
+
+TArray<FSoftObjectPath> UWeaponDataSubsystem::GetWeaponAssetPaths(const FWeaponDataTable& WeaponDataRow)
+{
+	TArray<FSoftObjectPath> AssetPaths;
+	auto AddPath = [&AssetPaths](const FSoftObjectPath& Path)
+	{
+		if(!Path.IsNull()) AssetPaths.AddUnique(Path);
+	};
+	AddPath(WeaponDataRow.WeaponMesh.ToSoftObjectPath());
+	AddPath(WeaponDataRow.WeaponIcon.ToSoftObjectPath());
+	AddPath(WeaponDataRow.AmmoTypeIcon.ToSoftObjectPath());
+	AddPath(WeaponDataRow.PickupSound.ToSoftObjectPath());
+	AddPath(WeaponDataRow.EquipSound.ToSoftObjectPath());
+	AddPath(WeaponDataRow.MaterialInstance.ToSoftObjectPath());
+	AddPath(WeaponDataRow.AnimBP.ToSoftObjectPath());
+	AddPath(WeaponDataRow.CrosshairMiddle.ToSoftObjectPath());
+	AddPath(WeaponDataRow.CrosshairRight.ToSoftObjectPath());
+	AddPath(WeaponDataRow.CrosshairLeft.ToSoftObjectPath());
+	AddPath(WeaponDataRow.CrosshairTop.ToSoftObjectPath());
+	AddPath(WeaponDataRow.CrosshairBottom.ToSoftObjectPath());
+	AddPath(WeaponDataRow.MuzzleFlash.ToSoftObjectPath());
+	AddPath(WeaponDataRow.FireSound.ToSoftObjectPath());
+	AddPath(WeaponDataRow.SlideDisplacementCurve.ToSoftObjectPath());
+	return AssetPaths;
+}
+
+void UWeaponDataSubsystem::RequestWeaponAssets(EWeaponType WeaponType, FStreamableDelegate OnLoaded)
+{
+	const FWeaponDataTable* WeaponDataRow{ GetWeaponData(WeaponType) };
+	if(WeaponDataRow == nullptr) return;
+
+	const int32 Index{ static_cast<int32>(WeaponType) };
+	if(AssetRequests.Num() <= Index)
+	{
+		AssetRequests.SetNum(static_cast<int32>(EWeaponType::EWT_DefaultMax));
+	}
+	FWeaponAssetRequest& Request = AssetRequests[Index];
+	Request.RefCount++;
+
+	if(!Request.Handle.IsValid())
+	{
+		Request.Handle = StreamableManager.RequestAsyncLoad(GetWeaponAssetPaths(*WeaponDataRow),
+			FStreamableDelegate::CreateUObject(this, &UWeaponDataSubsystem::OnWeaponAssetsLoaded, WeaponType));
+	}
+
+	// Nothing to load, or another weapon of this type already streamed the assets in
+	if(!Request.Handle.IsValid() || Request.Handle -> HasLoadCompleted())
+	{
+		OnLoaded.ExecuteIfBound();
+	}
+	else
+	{
+		Request.PendingCallbacks.Add(MoveTemp(OnLoaded));
+	}
+}
+
+void UWeaponDataSubsystem::ReleaseWeaponAssets(EWeaponType WeaponType)
+{
+	const int32 Index{ static_cast<int32>(WeaponType) };
+	if(!AssetRequests.IsValidIndex(Index)) return;
+
+	FWeaponAssetRequest& Request = AssetRequests[Index];
+	if(Request.RefCount == 0) return;
+	if(--Request.RefCount > 0) return;
+
+	// Last weapon of the type is gone, let the assets unload
+	if(Request.Handle.IsValid())
+	{
+		Request.Handle -> ReleaseHandle();
+	}
+	Request.Handle.Reset();
+	Request.PendingCallbacks.Empty();
+}
+
+void UWeaponDataSubsystem::OnWeaponAssetsLoaded(EWeaponType WeaponType)
+{
+	const int32 Index{ static_cast<int32>(WeaponType) };
+	if(!AssetRequests.IsValidIndex(Index)) return;
+
+	TArray<FStreamableDelegate> Callbacks = MoveTemp(AssetRequests[Index].PendingCallbacks);
+	AssetRequests[Index].PendingCallbacks.Reset();
+	for(FStreamableDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
+
+void UWeaponDataSubsystem::OnWeaponTableChanged()
+{
+	// Row pointers may be stale, resolve them again on the next lookup
+	bWeaponDataBuilt = false;
+}
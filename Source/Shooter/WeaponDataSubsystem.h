@@ -0,0 +1,87 @@
+﻿// Copyright 2025 JesseTheCatLover. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "WeaponType.h"
+#include "WeaponDataSubsystem.generated.h"
+
+struct FWeaponDataTable;
+class UDataTable;
+
+/** Streaming request for the assets of one weapon type, shared by every weapon of that type */
+struct FWeaponAssetRequest
+{
+	TSharedPtr<FStreamableHandle> Handle;
+
+	/** Number of weapons holding the request, assets are released when it drops to zero */
+	int32 RefCount{ 0 };
+
+	/** Weapons waiting for the load to complete */
+	TArray<FStreamableDelegate> PendingCallbacks;
+};
+
+/**
+ * Loads the weapon data table once and resolves its rows into an array indexed by EWeaponType,
+ * so weapons initialize without an object lookup or a row name search.
+ * Lives on the engine, so weapons constructed in the editor share the same cache.
+ * Also streams the assets of a weapon type in while any weapon of that type needs them.
+ */
+UCLASS(Config = Game)
+class SHOOTER_API UWeaponDataSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Resolved data of the weapon type, null if the table has no row for it */
+	const FWeaponDataTable* GetWeaponData(EWeaponType WeaponType);
+
+	/** Look the weapon data up through the engine's subsystem */
+	static const FWeaponDataTable* FindWeaponData(EWeaponType WeaponType);
+
+	/** Row of the weapon data table holding the weapon type */
+	static FName GetWeaponRowName(EWeaponType WeaponType);
+
+	/** Add a reference to the assets of the weapon type and stream them in if needed
+	 *  @param OnLoaded Called once the assets are resident, right away if they already are
+	 */
+	void RequestWeaponAssets(EWeaponType WeaponType, FStreamableDelegate OnLoaded);
+
+	/** Remove a reference added by RequestWeaponAssets, the last one lets the assets unload */
+	void ReleaseWeaponAssets(EWeaponType WeaponType);
+
+private:
+	/** Load the table if needed and resolve a row for every weapon type */
+	void BuildWeaponData();
+
+	/** Bound to the table, rows are resolved again after it gets edited or reimported */
+	void OnWeaponTableChanged();
+
+	/** Soft references of a row, everything a weapon of the type needs loaded */
+	static TArray<FSoftObjectPath> GetWeaponAssetPaths(const FWeaponDataTable& WeaponDataRow);
+
+	/** Bound to the streaming handle, notifies every weapon waiting for the weapon type */
+	void OnWeaponAssetsLoaded(EWeaponType WeaponType);
+
+	/** Path of the weapon data table */
+	UPROPERTY(Config)
+	FSoftObjectPath WeaponDataTablePath{ TEXT("/Game/_Game/DataTables/WeaponDataTable.WeaponDataTable") };
+
+	UPROPERTY()
+	UDataTable* WeaponDataTable;
+
+	/** Rows of WeaponDataTable, indexed by EWeaponType */
+	TArray<const FWeaponDataTable*> WeaponData;
+
+	/** True once the rows are resolved for the current table */
+	bool bWeaponDataBuilt{ false };
+
+	FStreamableManager StreamableManager;
+
+	/** Asset requests, indexed by EWeaponType */
+	TArray<FWeaponAssetRequest> AssetRequests;
+};